@@ -0,0 +1,330 @@
+/**
+ * Asynchronous File Reader Implementation
+ * Raw-syscall io_uring ring, pread fallback and the chunked CSV replay built on them
+ */
+
+#include "async_reader.h"
+#include "csv_processor.h" // CsvCommandReader
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+AsyncFileReader::AsyncFileReader(const std::string& path, bool preferIoUring) {
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        return;
+    }
+    struct stat info{};
+    if (::fstat(fd_, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+    fileSize_ = static_cast<std::uint64_t>(info.st_size);
+    blockCount_ = (fileSize_ + ASYNC_READ_BLOCK_BYTES - 1) / ASYNC_READ_BLOCK_BYTES;
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    depth_ = preferIoUring && setupRing() ? ASYNC_READ_DEPTH : 1;
+    buffers_.reset(new Buffer[depth_]);
+    for (unsigned i = 0; i < depth_; ++i) {
+        buffers_[i].data_.reset(new char[ASYNC_READ_BLOCK_BYTES]);
+    }
+
+    if (usesIoUring()) {
+        for (unsigned i = 0; i < depth_ && queuedBlocks_ < blockCount_; ++i) {
+            queueRead(i, queuedBlocks_);
+        }
+        if (pendingSubmits_ != 0 && !submitAndWait(pendingSubmits_, 0)) {
+            failed_ = true;
+        }
+    }
+}
+
+AsyncFileReader::~AsyncFileReader() {
+    if (usesIoUring()) {
+        // The kernel may still be writing into the buffers; let queued reads finish first
+        bool inFlight = true;
+        while (inFlight) {
+            reapCompletions();
+            inFlight = false;
+            for (unsigned i = 0; i < depth_; ++i) {
+                inFlight = inFlight || buffers_[i].inFlight_;
+            }
+            if (inFlight && !submitAndWait(pendingSubmits_, 1)) {
+                break;
+            }
+        }
+        teardownRing();
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool AsyncFileReader::setupRing() {
+    io_uring_params params{};
+    ringFd_ = static_cast<int>(::syscall(__NR_io_uring_setup, ASYNC_READ_DEPTH, &params));
+    if (ringFd_ < 0) {
+        ringFd_ = -1;
+        return false; // ENOSYS on old kernels, EPERM where io_uring is disabled
+    }
+
+    sqRingBytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingBytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        sqRingBytes_ = cqRingBytes_ = std::max(sqRingBytes_, cqRingBytes_);
+    }
+    sqesBytes_ = params.sq_entries * sizeof(io_uring_sqe);
+
+    sqRing_ = ::mmap(nullptr, sqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ringFd_, IORING_OFF_SQ_RING);
+    cqRing_ = singleMap ? sqRing_
+                        : ::mmap(nullptr, cqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                 ringFd_, IORING_OFF_CQ_RING);
+    sqes_ = ::mmap(nullptr, sqesBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ringFd_, IORING_OFF_SQES);
+    if (sqRing_ == MAP_FAILED || cqRing_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+        teardownRing();
+        return false;
+    }
+
+    char* sq = static_cast<char*>(sqRing_);
+    char* cq = static_cast<char*>(cqRing_);
+    sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = cq + params.cq_off.cqes;
+    return true;
+}
+
+void AsyncFileReader::teardownRing() {
+    if (sqes_ && sqes_ != MAP_FAILED) {
+        ::munmap(sqes_, sqesBytes_);
+    }
+    if (cqRing_ && cqRing_ != MAP_FAILED && cqRing_ != sqRing_) {
+        ::munmap(cqRing_, cqRingBytes_);
+    }
+    if (sqRing_ && sqRing_ != MAP_FAILED) {
+        ::munmap(sqRing_, sqRingBytes_);
+    }
+    sqRing_ = cqRing_ = sqes_ = nullptr;
+    if (ringFd_ >= 0) {
+        ::close(ringFd_);
+        ringFd_ = -1;
+    }
+}
+
+bool AsyncFileReader::queueRead(std::size_t bufferIndex, std::uint64_t block) {
+    Buffer& buffer = buffers_[bufferIndex];
+    std::uint64_t offset = block * ASYNC_READ_BLOCK_BYTES;
+    buffer.block_ = block;
+    buffer.vector_ = {buffer.data_.get(), static_cast<std::size_t>(std::min<std::uint64_t>(ASYNC_READ_BLOCK_BYTES, fileSize_ - offset))};
+    buffer.result_ = 0;
+    buffer.inFlight_ = true;
+    queuedBlocks_ = std::max(queuedBlocks_, block + 1);
+
+    // Only this thread writes the submission queue; at most depth_ reads are ever queued
+    unsigned tail = *sqTail_;
+    unsigned index = tail & *sqMask_;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd_;
+    sqe->addr = reinterpret_cast<std::uint64_t>(&buffer.vector_);
+    sqe->len = 1;
+    sqe->off = offset;
+    sqe->user_data = bufferIndex;
+    sqArray_[index] = index;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+    pendingSubmits_++;
+    return true;
+}
+
+bool AsyncFileReader::submitAndWait(unsigned toSubmit, unsigned minComplete) {
+    while (true) {
+        long submitted = ::syscall(__NR_io_uring_enter, ringFd_, toSubmit, minComplete,
+                                   minComplete ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+        if (submitted >= 0) {
+            pendingSubmits_ -= std::min<unsigned>(pendingSubmits_, static_cast<unsigned>(submitted));
+            return true;
+        }
+        if (errno != EINTR && errno != EAGAIN) {
+            return false;
+        }
+    }
+}
+
+void AsyncFileReader::reapCompletions() {
+    unsigned head = *cqHead_;
+    unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = static_cast<const io_uring_cqe*>(cqes_)[head & *cqMask_];
+        Buffer& buffer = buffers_[cqe.user_data];
+        buffer.result_ = cqe.res;
+        buffer.inFlight_ = false;
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+}
+
+bool AsyncFileReader::readSync(std::size_t bufferIndex, std::uint64_t block) {
+    Buffer& buffer = buffers_[bufferIndex];
+    std::uint64_t offset = block * ASYNC_READ_BLOCK_BYTES;
+    std::size_t length = static_cast<std::size_t>(std::min<std::uint64_t>(ASYNC_READ_BLOCK_BYTES, fileSize_ - offset));
+    std::size_t done = buffer.result_ > 0 ? static_cast<std::size_t>(buffer.result_) : 0;
+
+    while (done < length) {
+        ssize_t n = ::pread(fd_, buffer.data_.get() + done, length - done, static_cast<off_t>(offset + done));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false; // Error, or the file shrank underneath us
+        }
+        done += static_cast<std::size_t>(n);
+    }
+    buffer.block_ = block;
+    buffer.vector_.iov_len = length;
+    buffer.result_ = static_cast<std::int64_t>(length);
+    return true;
+}
+
+bool AsyncFileReader::next(std::string_view& block) {
+    if (failed_ || nextBlock_ >= blockCount_) {
+        return false;
+    }
+    std::size_t index = static_cast<std::size_t>(nextBlock_ % depth_);
+    Buffer& buffer = buffers_[index];
+
+    if (usesIoUring()) {
+        // The caller is done with the previous block, so its buffer goes back into the queue
+        if (nextBlock_ > 0 && queuedBlocks_ < blockCount_) {
+            queueRead(static_cast<std::size_t>((nextBlock_ - 1) % depth_), queuedBlocks_);
+        }
+        reapCompletions();
+        if (buffer.inFlight_) {
+            waits_++;
+        }
+        while (buffer.inFlight_) {
+            if (!submitAndWait(pendingSubmits_, 1)) {
+                failed_ = true;
+                return false;
+            }
+            reapCompletions();
+        }
+        if (pendingSubmits_ != 0 && !submitAndWait(pendingSubmits_, 0)) {
+            failed_ = true;
+            return false;
+        }
+        // Short reads and per-request errors (e.g. an opcode the kernel lacks) finish with pread
+        if (buffer.result_ < 0) {
+            buffer.result_ = 0;
+        }
+        if (static_cast<std::size_t>(buffer.result_) < buffer.vector_.iov_len && !readSync(index, nextBlock_)) {
+            failed_ = true;
+            return false;
+        }
+    } else {
+        buffer.result_ = 0;
+        if (!readSync(index, nextBlock_)) {
+            failed_ = true;
+            return false;
+        }
+    }
+
+    block = std::string_view(buffer.data_.get(), static_cast<std::size_t>(buffer.result_));
+    nextBlock_++;
+    return true;
+}
+
+bool processCsvFileAsync(const std::string& filename, OrderBook& orderBook, TradeTape* tape) {
+    AsyncFileReader input(filename);
+    if (!input.isOpen()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return false;
+    }
+
+    int lineNumber = 0;
+    int totalTrades = 0;
+    OrderCommand command;
+
+    // Parse complete lines, continuing the line count across blocks
+    auto parse = [&](std::string_view text, std::size_t baseOffset) {
+        CsvCommandReader reader(text, lineNumber, baseOffset);
+        while (reader.next(command)) {
+            try {
+                Trades trades = applyOrderCommand(orderBook, command);
+                totalTrades += trades.size();
+                if (tape) {
+                    tape->record(trades);
+                    tape->commit();
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error processing line " << reader.getLineNumber() << " (byte " << reader.getLineOffset()
+                          << "): " << e.what() << std::endl;
+            }
+        }
+        lineNumber = reader.getLineNumber();
+    };
+
+    std::cout << "Processing CSV file: " << filename << "\n";
+    std::cout << "=================================================\n";
+
+    std::string carry;            // Start of a line that continues in the next block
+    std::size_t carryOffset = 0;  // File offset of carry
+    std::size_t blockOffset = 0;  // File offset of the current block
+    std::string_view block;
+    while (input.next(block)) {
+        std::size_t start = 0;
+        if (!carry.empty()) {
+            std::size_t newline = block.find('\n');
+            if (newline == std::string_view::npos) {
+                carry.append(block);
+                blockOffset += block.size();
+                continue;
+            }
+            carry.append(block.substr(0, newline + 1));
+            parse(carry, carryOffset);
+            carry.clear();
+            start = newline + 1;
+        }
+
+        std::size_t last = block.rfind('\n');
+        std::size_t end = last == std::string_view::npos || last < start ? start : last + 1;
+        if (end > start) {
+            parse(block.substr(start, end - start), blockOffset + start);
+        }
+        if (end < block.size()) {
+            carryOffset = blockOffset + end;
+            carry.assign(block.substr(end));
+        }
+        blockOffset += block.size();
+    }
+    if (!carry.empty()) {
+        parse(carry, carryOffset);
+    }
+
+    std::cout << "=================================================\n";
+    std::cout << "CSV Processing Complete!\n";
+    std::cout << "Lines processed: " << lineNumber << "\n";
+    std::cout << "Total trades executed: " << totalTrades << "\n";
+    std::cout << "Final order book size: " << orderBook.getSize() << " orders\n";
+    std::cout << "Input: " << (input.usesIoUring() ? "io_uring" : "pread") << ", "
+              << (input.getFileSize() + ASYNC_READ_BLOCK_BYTES - 1) / ASYNC_READ_BLOCK_BYTES << " block(s) of "
+              << (ASYNC_READ_BLOCK_BYTES >> 10) << " KiB, replay waited on " << input.getWaitCount() << "\n";
+
+    if (input.hasFailed()) {
+        std::cerr << "Error: Read failed in " << filename << " after " << blockOffset << " bytes" << std::endl;
+        return false;
+    }
+    return true;
+}
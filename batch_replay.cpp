@@ -0,0 +1,180 @@
+/**
+ * Batch Replay Implementation
+ * Work-stealing-free pool: workers claim the next file index with one atomic increment
+ */
+
+#include "batch_replay.h"
+#include "binary_events.h"  // Binary input decoding
+#include "console_mute.h"   // Engine log suppression across workers
+#include "csv_processor.h"  // CSV input decoding
+#include "mapped_file.h"    // Zero-copy input
+#include "order_command.h"
+#include <algorithm>        // Sorting directory listings
+#include <atomic>
+#include <chrono>
+#include <filesystem>       // Directory expansion
+#include <iomanip>          // Report formatting
+#include <memory>
+#include <thread>
+
+namespace {
+
+template<typename Reader>
+void replayCommands(Reader& reader, OrderBook& orderBook, TradeTape* tape, ReplayStats& stats) {
+    OrderCommand command;
+    while (reader.next(command)) {
+        stats.events_++;
+        try {
+            Trades trades = applyOrderCommand(orderBook, command);
+            stats.trades_ += trades.size();
+            if (tape) {
+                tape->record(trades);
+                tape->commit();
+            }
+        } catch (const std::exception&) {
+            stats.rejected_++;
+        }
+    }
+}
+
+std::vector<std::string> expandInputs(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        std::error_code error;
+        if (!std::filesystem::is_directory(input, error)) {
+            files.push_back(input);
+            continue;
+        }
+
+        std::vector<std::string> listing;
+        for (const auto& entry : std::filesystem::directory_iterator(input, error)) {
+            if (entry.is_regular_file()) {
+                listing.push_back(entry.path().string());
+            }
+        }
+        std::sort(listing.begin(), listing.end());
+        files.insert(files.end(), listing.begin(), listing.end());
+    }
+    return files;
+}
+
+} // namespace
+
+ReplayStats replayFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape) {
+    ReplayStats stats;
+    stats.filename_ = filename;
+    auto start = std::chrono::steady_clock::now();
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        return stats;
+    }
+    stats.opened_ = true;
+
+    BinaryEventHeader header;
+    if (decodeBinaryEventHeader(file.data(), header)) {
+        BinaryEventReader reader(file.data());
+        replayCommands(reader, orderBook, tape, stats);
+    } else {
+        CsvCommandReader reader(file.data());
+        replayCommands(reader, orderBook, tape, stats);
+    }
+
+    stats.finalOrders_ = orderBook.getSize();
+    stats.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+std::vector<ReplayStats> replayBatch(const std::vector<std::string>& inputs, unsigned workers,
+                                     const std::string& tapeDirectory, TapeFormat tapeFormat,
+                                     TapeDurability tapeDurability) {
+    const std::vector<std::string> files = expandInputs(inputs);
+    std::vector<ReplayStats> results(files.size());
+    std::atomic<std::size_t> nextFile{0};
+
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers = static_cast<unsigned>(std::min<std::size_t>(workers, std::max<std::size_t>(files.size(), 1)));
+
+    auto worker = [&]() {
+        for (std::size_t index = nextFile.fetch_add(1); index < files.size(); index = nextFile.fetch_add(1)) {
+            std::unique_ptr<TradeTape> tape;
+            std::error_code error;
+            if (!tapeDirectory.empty() && std::filesystem::is_regular_file(files[index], error)) {
+                std::filesystem::path tapePath = std::filesystem::path(tapeDirectory) /
+                    (std::filesystem::path(files[index]).stem().string() +
+                     (tapeFormat == TapeFormat::BINARY ? ".trades.bin" : ".trades.csv"));
+                tape = std::make_unique<TradeTape>(tapePath.string(), tapeFormat, tapeDurability);
+                if (!tape->isOpen()) {
+                    std::cerr << "Error: Cannot create trade tape " << tapePath.string() << std::endl;
+                    tape.reset();
+                }
+            }
+
+            // Each file gets a fresh book owned by this worker alone
+            OrderBook orderBook;
+            results[index] = replayFile(files[index], orderBook, tape.get());
+        }
+    };
+
+    ConsoleMute mute;
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < workers; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker(); // The calling thread works too
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
+
+bool processBatch(const std::vector<std::string>& inputs, unsigned workers, const std::string& tapeDirectory,
+                  TapeFormat tapeFormat, TapeDurability tapeDurability) {
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (!tapeDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(tapeDirectory, error);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ReplayStats> results = replayBatch(inputs, workers, tapeDirectory, tapeFormat, tapeDurability);
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ReplayStats total;
+    double busySeconds = 0.0;
+    std::size_t failed = 0;
+
+    std::cout << "Batch replay of " << results.size() << " file(s) on " << workers << " worker(s)\n";
+    std::cout << "=================================================\n";
+    for (const ReplayStats& stats : results) {
+        if (!stats.opened_) {
+            std::cout << stats.filename_ << ": cannot open\n";
+            failed++;
+            continue;
+        }
+        std::cout << stats.filename_ << ": " << stats.events_ << " events, " << stats.trades_ << " trades, "
+                  << stats.rejected_ << " rejected, " << stats.finalOrders_ << " resting, "
+                  << std::fixed << std::setprecision(2) << stats.seconds_ * 1000.0 << " ms\n";
+        total.events_ += stats.events_;
+        total.trades_ += stats.trades_;
+        total.rejected_ += stats.rejected_;
+        total.finalOrders_ += stats.finalOrders_;
+        busySeconds += stats.seconds_;
+    }
+
+    std::cout << "=================================================\n";
+    std::cout << "Batch Replay Complete!\n";
+    std::cout << "Files replayed: " << results.size() - failed << " (" << failed << " failed)\n";
+    std::cout << "Events processed: " << total.events_ << "\n";
+    std::cout << "Total trades executed: " << total.trades_ << "\n";
+    std::cout << "Rejected commands: " << total.rejected_ << "\n";
+    std::cout << "Final resting orders: " << total.finalOrders_ << "\n";
+    std::cout << "Wall time: " << std::fixed << std::setprecision(2) << wallSeconds * 1000.0 << " ms, summed file time: "
+              << busySeconds * 1000.0 << " ms (parallel speedup " << (wallSeconds > 0 ? busySeconds / wallSeconds : 0.0)
+              << "x)\n";
+    return failed == 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * Batch Replay Module
+ * Replays many independent order files in parallel, one order book per file
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "trade_tape.h"
+#include <string>
+#include <vector>
+
+/**
+ * Outcome of replaying one file
+ */
+struct ReplayStats
+{
+    std::string filename_;      // Input file
+    bool opened_ = false;       // Whether the file could be read
+    std::uint64_t events_ = 0;  // Commands applied (including ones the engine rejected)
+    std::uint64_t trades_ = 0;  // Trades generated
+    std::uint64_t rejected_ = 0; // Commands the engine rejected with an exception
+    std::size_t finalOrders_ = 0; // Orders resting at the end
+    double seconds_ = 0.0;      // Wall time spent on this file
+};
+
+/**
+ * Replay one CSV or binary event file into an order book without console output
+ * The format is detected from the binary event header
+ * @param filename Path to input file
+ * @param orderBook Order book to replay into
+ * @param tape Optional tape receiving every trade
+ * @return Replay statistics
+ */
+ReplayStats replayFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape = nullptr);
+
+/**
+ * Replay files across a pool of worker threads
+ * Directories are expanded to the regular files they contain (sorted by name). Each file
+ * gets its own OrderBook on whichever worker picks it up, so workers share nothing but the
+ * index of the next file. The engine log is muted for the duration.
+ * @param inputs Files and/or directories
+ * @param workers Number of worker threads (0 uses the hardware concurrency)
+ * @param tapeDirectory Optional directory receiving one trade tape per input file
+ * @param tapeFormat Tape encoding
+ * @param tapeDurability Tape flush policy
+ * @return Per-file statistics in input order
+ */
+std::vector<ReplayStats> replayBatch(const std::vector<std::string>& inputs, unsigned workers,
+                                     const std::string& tapeDirectory = "",
+                                     TapeFormat tapeFormat = TapeFormat::BINARY,
+                                     TapeDurability tapeDurability = TapeDurability::BUFFERED);
+
+/**
+ * Run replayBatch and print per-file and aggregate statistics
+ * @return true if every file was replayed
+ */
+bool processBatch(const std::vector<std::string>& inputs, unsigned workers, const std::string& tapeDirectory,
+                  TapeFormat tapeFormat, TapeDurability tapeDurability);
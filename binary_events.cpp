@@ -0,0 +1,178 @@
+/**
+ * Binary Order Event Implementation
+ * Record encoding, CSV conversion and binary replay
+ */
+
+#include "binary_events.h"
+#include "byte_order.h"     // Little-endian record fields
+#include "csv_processor.h"  // CSV decoding for the converter
+#include "mapped_file.h"    // Zero-copy replay input
+#include <algorithm>        // std::min for truncated files
+#include <cstring>          // memcmp/memcpy for the magic
+#include <fstream>          // Converter output
+#include <vector>           // Converter write buffer
+
+namespace {
+
+constexpr std::size_t CONVERTER_BUFFER_RECORDS = 32768; // 1 MiB of records per write
+
+} // namespace
+
+void encodeBinaryEventHeader(const BinaryEventHeader& header, char* out) {
+    std::memcpy(out, BINARY_EVENT_MAGIC, sizeof(BINARY_EVENT_MAGIC));
+    storeLittleEndian<std::uint16_t>(out + 4, header.version_);
+    storeLittleEndian<std::uint16_t>(out + 6, header.recordSize_);
+    storeLittleEndian<std::uint64_t>(out + 8, header.recordCount_);
+}
+
+bool decodeBinaryEventHeader(std::string_view data, BinaryEventHeader& header) {
+    if (data.size() < BINARY_EVENT_HEADER_SIZE ||
+        std::memcmp(data.data(), BINARY_EVENT_MAGIC, sizeof(BINARY_EVENT_MAGIC)) != 0) {
+        return false;
+    }
+    header.version_ = loadLittleEndian<std::uint16_t>(data.data() + 4);
+    header.recordSize_ = loadLittleEndian<std::uint16_t>(data.data() + 6);
+    header.recordCount_ = loadLittleEndian<std::uint64_t>(data.data() + 8);
+    return header.version_ == BINARY_EVENT_VERSION && header.recordSize_ >= BINARY_EVENT_RECORD_SIZE;
+}
+
+void encodeBinaryEvent(const OrderCommand& command, char* out) {
+    storeLittleEndian<std::uint64_t>(out, command.timestamp_);
+    storeLittleEndian<std::uint64_t>(out + 8, command.orderId_);
+    storeLittleEndian<std::uint32_t>(out + 16, static_cast<std::uint32_t>(command.price_));
+    storeLittleEndian<std::uint32_t>(out + 20, command.quantity_);
+    out[24] = static_cast<char>(command.action_);
+    out[25] = static_cast<char>(command.side_ == OrderSide::BUY ? 0 : 1);
+    out[26] = static_cast<char>(command.type_ == OrderType::GTC ? 0 : 1);
+    std::memset(out + 27, 0, BINARY_EVENT_RECORD_SIZE - 27);
+}
+
+bool decodeBinaryEvent(const char* record, OrderCommand& command) {
+    auto action = static_cast<std::uint8_t>(record[24]);
+    auto side = static_cast<std::uint8_t>(record[25]);
+    auto type = static_cast<std::uint8_t>(record[26]);
+    if (action > static_cast<std::uint8_t>(OrderAction::CANCEL) || side > 1 || type > 1) {
+        return false;
+    }
+
+    command.timestamp_ = loadLittleEndian<std::uint64_t>(record);
+    command.orderId_ = loadLittleEndian<std::uint64_t>(record + 8);
+    command.price_ = static_cast<std::int32_t>(loadLittleEndian<std::uint32_t>(record + 16));
+    command.quantity_ = loadLittleEndian<std::uint32_t>(record + 20);
+    command.action_ = static_cast<OrderAction>(action);
+    command.side_ = side == 0 ? OrderSide::BUY : OrderSide::SELL;
+    command.type_ = type == 0 ? OrderType::GTC : OrderType::FOK;
+    return true;
+}
+
+BinaryEventReader::BinaryEventReader(std::string_view data) : data_(data) {
+    valid_ = decodeBinaryEventHeader(data_, header_);
+    if (valid_) {
+        std::uint64_t available = (data_.size() - BINARY_EVENT_HEADER_SIZE) / header_.recordSize_;
+        recordCount_ = std::min(available, header_.recordCount_);
+    }
+}
+
+bool BinaryEventReader::next(OrderCommand& command) {
+    while (nextRecord_ < recordCount_) {
+        recordOffset_ = BINARY_EVENT_HEADER_SIZE + nextRecord_ * header_.recordSize_;
+        nextRecord_++;
+        if (decodeBinaryEvent(data_.data() + recordOffset_, command)) {
+            return true;
+        }
+        std::cerr << "Error decoding record " << nextRecord_ - 1 << " at byte " << recordOffset_ << std::endl;
+    }
+    return false;
+}
+
+bool convertCsvToBinary(const std::string& csvFile, const std::string& binaryFile) {
+    MappedFile input(csvFile);
+    if (!input.isOpen()) {
+        std::cerr << "Error: Cannot open file " << csvFile << std::endl;
+        return false;
+    }
+
+    std::ofstream output(binaryFile, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Error: Cannot create file " << binaryFile << std::endl;
+        return false;
+    }
+
+    BinaryEventHeader header{BINARY_EVENT_VERSION, BINARY_EVENT_RECORD_SIZE, 0};
+    char headerBytes[BINARY_EVENT_HEADER_SIZE];
+    encodeBinaryEventHeader(header, headerBytes);
+    output.write(headerBytes, sizeof(headerBytes)); // Rewritten with the final count below
+
+    std::vector<char> buffer(CONVERTER_BUFFER_RECORDS * BINARY_EVENT_RECORD_SIZE);
+    std::size_t buffered = 0;
+    CsvCommandReader reader(input.data());
+    OrderCommand command;
+
+    while (reader.next(command)) {
+        encodeBinaryEvent(command, buffer.data() + buffered * BINARY_EVENT_RECORD_SIZE);
+        header.recordCount_++;
+        if (++buffered == CONVERTER_BUFFER_RECORDS) {
+            output.write(buffer.data(), buffered * BINARY_EVENT_RECORD_SIZE);
+            buffered = 0;
+        }
+    }
+    output.write(buffer.data(), buffered * BINARY_EVENT_RECORD_SIZE);
+
+    encodeBinaryEventHeader(header, headerBytes);
+    output.seekp(0);
+    output.write(headerBytes, sizeof(headerBytes));
+    output.close();
+
+    if (!output) {
+        std::cerr << "Error: Failed writing " << binaryFile << std::endl;
+        return false;
+    }
+    std::cout << "Converted " << header.recordCount_ << " event(s) from " << reader.getLineNumber()
+              << " line(s) of " << csvFile << " into " << binaryFile << "\n";
+    return true;
+}
+
+void processBinaryFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return;
+    }
+
+    BinaryEventReader reader(file.data());
+    if (!reader.isValid()) {
+        std::cerr << "Error: " << filename << " is not a version " << BINARY_EVENT_VERSION
+                  << " order event file" << std::endl;
+        return;
+    }
+    if (reader.getRecordCount() < reader.getHeader().recordCount_) {
+        std::cerr << "Warning: " << filename << " is truncated - header lists " << reader.getHeader().recordCount_
+                  << " record(s), file holds " << reader.getRecordCount() << std::endl;
+    }
+
+    OrderCommand command;
+    int totalTrades = 0;
+
+    std::cout << "Processing binary event file: " << filename << "\n";
+    std::cout << "=================================================\n";
+
+    while (reader.next(command)) {
+        try {
+            Trades trades = applyOrderCommand(orderBook, command);
+            totalTrades += trades.size();
+            if (tape) {
+                tape->record(trades);
+                tape->commit();
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error processing record at byte " << reader.getRecordOffset() << ": "
+                      << e.what() << std::endl;
+        }
+    }
+
+    std::cout << "=================================================\n";
+    std::cout << "Binary Replay Complete!\n";
+    std::cout << "Records processed: " << reader.getRecordCount() << "\n";
+    std::cout << "Total trades executed: " << totalTrades << "\n";
+    std::cout << "Final order book size: " << orderBook.getSize() << " orders\n";
+}
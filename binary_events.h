@@ -0,0 +1,128 @@
+/**
+ * Binary Order Event Module
+ * Fixed-width little-endian record format for order events, a converter from the CSV
+ * layout and a replay path that decodes records straight into engine calls
+ *
+ * File layout:
+ *   header (16 bytes): magic "OBEV", u16 version, u16 record size, u64 record count
+ *   records (record size bytes each):
+ *     u64 timestamp (ns), u64 order id, i32 price, u32 quantity,
+ *     u8 action, u8 side, u8 type, 5 reserved bytes (zero)
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "order_command.h"
+#include "trade_tape.h"
+#include <string>
+#include <string_view>
+
+constexpr char BINARY_EVENT_MAGIC[4] = {'O', 'B', 'E', 'V'};
+constexpr std::uint16_t BINARY_EVENT_VERSION = 1;
+constexpr std::size_t BINARY_EVENT_HEADER_SIZE = 16;
+constexpr std::size_t BINARY_EVENT_RECORD_SIZE = 32;
+
+/**
+ * Decoded file header
+ */
+struct BinaryEventHeader
+{
+    std::uint16_t version_;     // Format version
+    std::uint16_t recordSize_;  // Stride between records (newer versions may append fields)
+    std::uint64_t recordCount_; // Records that follow the header
+};
+
+/**
+ * Write a header
+ * @param header Header to encode
+ * @param out Destination of BINARY_EVENT_HEADER_SIZE bytes
+ */
+void encodeBinaryEventHeader(const BinaryEventHeader& header, char* out);
+
+/**
+ * Read and validate a header
+ * @param data Start of the file
+ * @param header Receives the header
+ * @return true if the magic matches, the version is supported and the record size is usable
+ */
+bool decodeBinaryEventHeader(std::string_view data, BinaryEventHeader& header);
+
+/**
+ * Write one record
+ * @param command Command to encode (its timestamp is stored as well)
+ * @param out Destination of BINARY_EVENT_RECORD_SIZE bytes
+ */
+void encodeBinaryEvent(const OrderCommand& command, char* out);
+
+/**
+ * Read one record
+ * @param record Start of the record
+ * @param command Receives the decoded command
+ * @return false if the action, side or type byte is not a known value
+ */
+bool decodeBinaryEvent(const char* record, OrderCommand& command);
+
+/**
+ * Pull-style reader over a mapped binary event file
+ * Undecodable records are reported to stderr with their index and byte offset and skipped
+ */
+class BinaryEventReader
+{
+    public:
+    /**
+     * Create a reader and validate the header
+     * @param data Whole file (must outlive the reader)
+     */
+    explicit BinaryEventReader(std::string_view data);
+
+    /**
+     * Check whether the header was valid
+     * @return true if records can be read
+     */
+    bool isValid() const { return valid_; }
+
+    const BinaryEventHeader& getHeader() const { return header_; }
+
+    /**
+     * Records actually present (fewer than the header lists if the file is truncated)
+     */
+    std::uint64_t getRecordCount() const { return recordCount_; }
+
+    /**
+     * Decode the next valid record
+     * @param command Receives the command
+     * @return false once all records are read
+     */
+    bool next(OrderCommand& command);
+
+    /**
+     * Byte offset of the last record read
+     */
+    std::size_t getRecordOffset() const { return recordOffset_; }
+
+    private:
+    std::string_view data_;         // Whole file
+    BinaryEventHeader header_{};    // Decoded header
+    bool valid_ = false;            // Header check result
+    std::uint64_t recordCount_ = 0; // Records present
+    std::uint64_t nextRecord_ = 0;  // Index of the next record to read
+    std::size_t recordOffset_ = 0;  // Offset of the last record read
+};
+
+/**
+ * Convert a CSV order file to the binary event format
+ * Malformed CSV lines are reported and left out
+ * @param csvFile Path to CSV input
+ * @param binaryFile Path to binary output (overwritten)
+ * @return true if the output was written completely
+ */
+bool convertCsvToBinary(const std::string& csvFile, const std::string& binaryFile);
+
+/**
+ * Replay a binary event file against an order book
+ * @param filename Path to binary event file
+ * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade (committed after each record)
+ */
+void processBinaryFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape = nullptr);
@@ -0,0 +1,123 @@
+/**
+ * Book Manager Module
+ * Owns one order book per instrument and routes order commands to them
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "order_command.h"
+#include "trade_tape.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Compact instrument identifier - dense index into the manager's books
+ */
+using SymbolId = std::uint32_t;
+
+constexpr SymbolId NO_SYMBOL = UINT32_MAX; // Command without a symbol
+
+/**
+ * Hash that lets string_view look up std::string symbol keys without building a string
+ */
+struct SymbolHash
+{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view symbol) const { return std::hash<std::string_view>{}(symbol); }
+};
+
+/**
+ * Symbol name to id map with allocation-free lookups
+ */
+using SymbolIndex = std::unordered_map<std::string, SymbolId, SymbolHash, std::equal_to<>>;
+
+/**
+ * How order ids are scoped across books
+ */
+enum class OrderIdScope
+{
+    PER_SYMBOL, // Each book has its own id space; every command must name its symbol
+    GLOBAL      // Ids are unique across books; CANCEL/MODIFY can be routed by id alone
+};
+
+/**
+ * Set of order books keyed by SymbolId
+ * Symbols are interned once into dense ids, so routing a command is an index into a vector.
+ * In GLOBAL scope an id-to-symbol index finds the book of a CANCEL/MODIFY that names none,
+ * and keeps one id from resting in two books at once.
+ */
+class BookManager
+{
+    public:
+    /**
+     * Create an empty manager
+     * @param scope Order id namespace policy
+     */
+    explicit BookManager(OrderIdScope scope = OrderIdScope::PER_SYMBOL) : scope_(scope) {}
+
+    // Books report removed ids into removed_, so the manager must not be copied
+    BookManager(const BookManager&) = delete;
+    BookManager& operator=(const BookManager&) = delete;
+
+    /**
+     * Get the id of a symbol, creating its book on first use
+     * @param symbol Instrument name
+     * @return Dense symbol id
+     */
+    SymbolId addSymbol(std::string_view symbol);
+
+    /**
+     * Look up a symbol without creating it
+     * @param symbol Instrument name
+     * @return Symbol id, or NO_SYMBOL if unknown
+     */
+    SymbolId findSymbol(std::string_view symbol) const;
+
+    const std::string& getSymbolName(SymbolId symbol) const { return names_[symbol]; }
+    std::size_t getBookCount() const { return books_.size(); }
+    OrderIdScope getScope() const { return scope_; }
+
+    OrderBook& getBook(SymbolId symbol) { return *books_[symbol]; }
+    const OrderBook& getBook(SymbolId symbol) const { return *books_[symbol]; }
+
+    /**
+     * Total resting orders across all books
+     */
+    std::size_t getOrderCount() const;
+
+    /**
+     * Route a command to its book and apply it
+     * @param symbol Target book, or NO_SYMBOL to route a CANCEL/MODIFY by order id (GLOBAL scope only)
+     * @param command Operation to apply
+     * @return Trades generated by the operation
+     * @throws std::invalid_argument if the book cannot be determined, the id already rests in
+     *         another book (GLOBAL scope), or the book rejects the command
+     */
+    Trades apply(SymbolId symbol, const OrderCommand& command);
+
+    private:
+    SymbolId routeById(const OrderCommand& command) const;
+    void forgetRemoved(const OrderBook& book);
+
+    OrderIdScope scope_;
+    SymbolIndex ids_;                                    // Symbol -> id
+    std::vector<std::string> names_;                     // Id -> symbol
+    std::vector<std::unique_ptr<OrderBook>> books_;      // Id -> book
+    std::unordered_map<OrderId, SymbolId> orderSymbols_; // GLOBAL scope: resting id -> book
+    std::vector<OrderId> removed_;                       // GLOBAL scope: ids the last command took out of its book
+};
+
+/**
+ * Process a CSV order file whose lines may start with a symbol column
+ * Lines with a symbol go to that symbol's book (created on first use). Lines without one go
+ * by order id in GLOBAL scope, and are rejected in PER_SYMBOL scope.
+ * @param filename Path to CSV file
+ * @param books Books to process orders against
+ * @param tape Optional tape receiving every trade (committed after each command)
+ */
+void processMultiSymbolCsvFile(const std::string& filename, BookManager& books, TradeTape* tape = nullptr);
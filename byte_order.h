@@ -0,0 +1,49 @@
+/**
+ * Byte Order Helpers
+ * Explicit byte order encoding for the binary file and feed formats
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Store an unsigned integer as little-endian bytes
+ * Compilers fold this into a single store on little-endian targets
+ * @param out Destination of sizeof(T) bytes
+ * @param value Value to store
+ */
+template<typename T>
+void storeLittleEndian(char* out, T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+/**
+ * Load an unsigned integer from little-endian bytes
+ * @param in Source of sizeof(T) bytes
+ * @return Decoded value
+ */
+template<typename T>
+T loadLittleEndian(const char* in) {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * Load an unsigned integer from big-endian (network order) bytes
+ * @param in Source of Bytes bytes
+ * @return Decoded value
+ */
+template<typename T, std::size_t Bytes = sizeof(T)>
+T loadBigEndian(const char* in) {
+    T value = 0;
+    for (std::size_t i = 0; i < Bytes; ++i) {
+        value = static_cast<T>((value << 8) | static_cast<unsigned char>(in[i]));
+    }
+    return value;
+}
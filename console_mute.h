@@ -0,0 +1,38 @@
+/**
+ * Console Mute Module
+ * Suppresses the engine's std::cout logging for machine-oriented modes
+ */
+
+#pragma once
+
+#include <iostream>
+#include <streambuf>
+
+/**
+ * Stream buffer that discards everything written to it
+ * It has no put area and keeps no state, so any number of threads may write through it
+ */
+class NullStreamBuf : public std::streambuf
+{
+    protected:
+    int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+/**
+ * Redirects std::cout to a NullStreamBuf for the lifetime of the guard
+ * The stream stays in a good state, so muted logging is cheap and does not race on stream flags
+ */
+class ConsoleMute
+{
+    public:
+    ConsoleMute() : saved_(std::cout.rdbuf(&discard_)) {}
+    ~ConsoleMute() { std::cout.rdbuf(saved_); }
+
+    ConsoleMute(const ConsoleMute&) = delete;
+    ConsoleMute& operator=(const ConsoleMute&) = delete;
+
+    private:
+    NullStreamBuf discard_;
+    std::streambuf* saved_;
+};
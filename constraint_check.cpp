@@ -0,0 +1,254 @@
+/**
+ * Constraint Check Module Implementation
+ * Random order flow replayed through OrderBook and a scan-everything reference book
+ */
+
+#include "constraint_check.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "console_mute.h"
+#include "orderbook.h"
+
+namespace {
+
+/**
+ * Resting order in the reference book
+ */
+struct ReferenceOrder
+{
+    OrderId id_;
+    std::uint32_t remaining_;
+    FillConstraint constraint_;
+    std::uint32_t minimumQuantity_;
+
+    std::uint32_t threshold() const {
+        switch (constraint_) {
+            case FillConstraint::ALL_OR_NONE:
+                return remaining_;
+            case FillConstraint::MIN_QUANTITY:
+                return std::min(minimumQuantity_, remaining_);
+            default:
+                return 0;
+        }
+    }
+};
+
+/**
+ * Trade as the reference produces it
+ */
+struct ReferenceTrade
+{
+    OrderId bid_;
+    OrderId ask_;
+    std::int32_t price_;
+    std::uint32_t quantity_;
+};
+
+/**
+ * Price-time book that finds every match by scanning the whole level in arrival order
+ * Every step rescans the side best-first and trades the earliest eligible order at the first
+ * level holding one, so a level passed over is revisited once the incoming order can use it.
+ */
+class ReferenceBook
+{
+    public:
+    std::vector<ReferenceTrade> submit(OrderSide side, std::int32_t price, ReferenceOrder incoming) {
+        std::vector<ReferenceTrade> trades;
+        auto walk = [&](auto& levels, auto crosses) {
+            while (incoming.remaining_ > 0) {
+                // Earliest eligible order at the best crossing level that holds one
+                auto levelIt = levels.begin();
+                std::vector<ReferenceOrder>::iterator match;
+                for (; levelIt != levels.end() && crosses(levelIt->first); ++levelIt) {
+                    auto& queue = levelIt->second;
+                    match = std::find_if(queue.begin(), queue.end(), [&](const ReferenceOrder& resting) {
+                        return resting.threshold() <= incoming.remaining_ && resting.remaining_ >= incoming.threshold();
+                    });
+                    if (match != queue.end()) {
+                        break;
+                    }
+                }
+                if (levelIt == levels.end() || !crosses(levelIt->first)) {
+                    break;
+                }
+                auto& queue = levelIt->second;
+                std::uint32_t quantity = std::min(match->remaining_, incoming.remaining_);
+                trades.push_back(side == OrderSide::BUY
+                    ? ReferenceTrade{incoming.id_, match->id_, levelIt->first, quantity}
+                    : ReferenceTrade{match->id_, incoming.id_, levelIt->first, quantity});
+                incoming.remaining_ -= quantity;
+                match->remaining_ -= quantity;
+                if (match->remaining_ == 0) {
+                    sides_.erase(match->id_);
+                    queue.erase(match);
+                    if (queue.empty()) {
+                        levels.erase(levelIt);
+                    }
+                }
+            }
+        };
+        if (side == OrderSide::BUY) {
+            walk(asks_, [&](std::int32_t ask) { return price >= ask; });
+        } else {
+            walk(bids_, [&](std::int32_t bid) { return price <= bid; });
+        }
+        if (incoming.remaining_ > 0) {
+            if (side == OrderSide::BUY) {
+                bids_[price].push_back(incoming);
+            } else {
+                asks_[price].push_back(incoming);
+            }
+            sides_[incoming.id_] = {side, price};
+        }
+        return trades;
+    }
+
+    void cancel(OrderId id) {
+        auto found = sides_.find(id);
+        if (found == sides_.end()) {
+            return;
+        }
+        auto [side, price] = found->second;
+        sides_.erase(found);
+        auto cancelFrom = [&](auto& levels) {
+            auto& queue = levels.at(price);
+            std::erase_if(queue, [&](const ReferenceOrder& order) { return order.id_ == id; });
+            if (queue.empty()) {
+                levels.erase(price);
+            }
+        };
+        side == OrderSide::BUY ? cancelFrom(bids_) : cancelFrom(asks_);
+    }
+
+    /**
+     * Visit every resting order as visit(order)
+     */
+    template<typename Visit>
+    void forEachOrder(Visit visit) const {
+        for (const auto& [price, queue] : bids_) {
+            for (const ReferenceOrder& order : queue) visit(order);
+        }
+        for (const auto& [price, queue] : asks_) {
+            for (const ReferenceOrder& order : queue) visit(order);
+        }
+    }
+
+    std::size_t size() const { return sides_.size(); }
+
+    private:
+    std::map<std::int32_t, std::vector<ReferenceOrder>, std::greater<std::int32_t>> bids_;
+    std::map<std::int32_t, std::vector<ReferenceOrder>, std::less<std::int32_t>> asks_;
+    std::unordered_map<OrderId, std::pair<OrderSide, std::int32_t>> sides_;  // Resting id -> side and price
+};
+
+} // namespace
+
+bool checkFillConstraints(std::size_t orderCount) {
+    std::mt19937 random(20240611);
+    auto between = [&](std::uint32_t low, std::uint32_t high) {
+        return std::uniform_int_distribution<std::uint32_t>(low, high)(random);
+    };
+
+    OrderBook orderBook;
+    ReferenceBook reference;
+    std::unordered_map<OrderId, ReferenceOrder> submitted;  // Id -> constraint and engine-side remainder
+    std::vector<OrderId> ids;
+    std::size_t cancels = 0;
+    std::size_t tradeCount = 0;
+    std::size_t failures = 0;
+
+    // Reports a failure; the first few are printed
+    auto fail = [&](const std::string& message) {
+        if (failures++ < 10) {
+            std::cout << "[CONSTRAINTS] " << message << "\n";
+        }
+    };
+
+    // Check that one side of an engine trade respected its own constraint
+    auto checkSide = [&](OrderId id, std::uint32_t quantity) {
+        ReferenceOrder& order = submitted.at(id);
+        if (order.constraint_ == FillConstraint::ALL_OR_NONE && quantity != order.remaining_) {
+            fail("all-or-none order " + std::to_string(id) + " traded " + std::to_string(quantity) + " of " +
+                 std::to_string(order.remaining_));
+        }
+        if (order.constraint_ == FillConstraint::MIN_QUANTITY && quantity < order.threshold()) {
+            fail("minimum-quantity order " + std::to_string(id) + " traded " + std::to_string(quantity) +
+                 " below its threshold " + std::to_string(order.threshold()));
+        }
+        order.remaining_ -= std::min(quantity, order.remaining_);
+    };
+
+    {
+        ConsoleMute mute;
+        for (OrderId id = 1; id <= orderCount; ++id) {
+            if (!ids.empty() && between(0, 7) == 0) {
+                OrderId victim = ids[between(0, static_cast<std::uint32_t>(ids.size() - 1))];
+                orderBook.cancelOrder(victim);
+                reference.cancel(victim);
+                cancels++;
+            }
+
+            // A narrow price band keeps levels deep and crossing often
+            OrderSide side = between(0, 1) ? OrderSide::BUY : OrderSide::SELL;
+            std::int32_t price = static_cast<std::int32_t>(between(98, 102));
+            ReferenceOrder order{id, between(1, 40), FillConstraint::NONE, 0};
+            std::uint32_t kind = between(0, 9);
+            if (kind < 2) {
+                order.constraint_ = FillConstraint::ALL_OR_NONE;
+            } else if (kind < 5) {
+                order.constraint_ = FillConstraint::MIN_QUANTITY;
+                order.minimumQuantity_ = between(1, 30);
+            }
+            submitted.emplace(id, order);
+            ids.push_back(id);
+
+            Trades trades = orderBook.addOrder(std::make_shared<Order>(id, side, OrderType::GTC, Price(price),
+                Quantity(order.remaining_), order.constraint_, order.minimumQuantity_));
+            std::vector<ReferenceTrade> expected = reference.submit(side, price, order);
+
+            if (trades.size() != expected.size()) {
+                fail("order " + std::to_string(id) + " produced " + std::to_string(trades.size()) +
+                     " trade(s), reference " + std::to_string(expected.size()));
+            }
+            for (std::size_t i = 0; i < trades.size(); ++i) {
+                const Trade& trade = trades[i];
+                std::uint32_t quantity = trade.getBid().quantity_.get();
+                checkSide(trade.getBid().orderId_, quantity);
+                checkSide(trade.getAsk().orderId_, quantity);
+                if (i < expected.size() &&
+                    (trade.getBid().orderId_ != expected[i].bid_ || trade.getAsk().orderId_ != expected[i].ask_ ||
+                     trade.getPrice().get() != expected[i].price_ || quantity != expected[i].quantity_)) {
+                    fail("order " + std::to_string(id) + " trade " + std::to_string(i) + ": " +
+                         std::to_string(trade.getBid().orderId_) + "/" + std::to_string(trade.getAsk().orderId_) +
+                         " " + std::to_string(quantity) + " @ " + std::to_string(trade.getPrice().get()) +
+                         ", reference " + std::to_string(expected[i].bid_) + "/" + std::to_string(expected[i].ask_) +
+                         " " + std::to_string(expected[i].quantity_) + " @ " + std::to_string(expected[i].price_));
+                }
+            }
+            tradeCount += trades.size();
+        }
+    }
+
+    // Every reference order must rest in the engine with the same remainder, and nothing else may
+    reference.forEachOrder([&](const ReferenceOrder& order) {
+        OrderPointer resting = orderBook.findOrder(order.id_);
+        if (!resting || resting->getRemainingQuantity().get() != order.remaining_) {
+            fail("order " + std::to_string(order.id_) + " rests with " +
+                 (resting ? std::to_string(resting->getRemainingQuantity().get()) : std::string("nothing")) +
+                 ", reference " + std::to_string(order.remaining_));
+        }
+    });
+    if (orderBook.getSize() != reference.size()) {
+        fail("engine rests " + std::to_string(orderBook.getSize()) + " order(s), reference " +
+             std::to_string(reference.size()));
+    }
+
+    std::cout << "[CONSTRAINTS] " << orderCount << " order(s), " << cancels << " cancel(s), " << tradeCount
+              << " trade(s), " << reference.size() << " resting: "
+              << (failures == 0 ? "engine matches the reference" : std::to_string(failures) + " failure(s)") << "\n";
+    return failures == 0;
+}
@@ -0,0 +1,18 @@
+/**
+ * Constraint Check Module
+ * Verifies all-or-none and minimum-quantity matching against a brute-force reference book
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Drive a random stream of constrained and unconstrained orders through the order book and a
+ * reference matcher that scans every resting order, and compare every trade and the final book.
+ * Each engine trade is also checked directly: an all-or-none order only trades its whole
+ * remainder, and a minimum-quantity order never trades less than min(minimum, remainder).
+ * @param orderCount Number of orders to submit (roughly one in eight events is a cancel instead)
+ * @return true if the engine matched the reference and no constraint was violated
+ */
+bool checkFillConstraints(std::size_t orderCount);
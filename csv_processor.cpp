@@ -4,129 +4,208 @@
  */
 
 #include "csv_processor.h"
-#include <fstream>      // File I/O for CSV processing
-#include <sstream>      // String stream for CSV parsing
-#include <limits>       // For numeric limits checking
-
-template<typename T>
-T safeStringToNumber(const std::string& str) {
-    if constexpr (std::is_same_v<T, std::uint64_t>) {
-        unsigned long long val = std::stoull(str);
-        if (val > std::numeric_limits<std::uint64_t>::max()) {
-            throw std::out_of_range("Value too large for uint64_t: " + str);
-        }
-        return static_cast<T>(val);
-    } else if constexpr (std::is_same_v<T, std::uint32_t>) {
-        unsigned long val = std::stoul(str);
-        if (val > std::numeric_limits<std::uint32_t>::max()) {
-            throw std::out_of_range("Value too large for uint32_t: " + str);
-        }
-        return static_cast<T>(val);
-    } else if constexpr (std::is_same_v<T, std::int32_t>) {
-        int val = std::stoi(str);
-        if (val < std::numeric_limits<std::int32_t>::min() || 
-            val > std::numeric_limits<std::int32_t>::max()) {
-            throw std::out_of_range("Value out of range for int32_t: " + str);
+#include "mapped_file.h"    // Zero-copy file access
+#include <algorithm>        // std::min for block sizing
+#include <cstring>          // memchr for field scanning
+
+const char* csvStatusName(CsvStatus status) {
+    switch (status) {
+        case CsvStatus::OK: return "ok";
+        case CsvStatus::SKIPPED: return "skipped";
+        case CsvStatus::MISSING_FIELD: return "missing field";
+        case CsvStatus::INVALID_NUMBER: return "invalid number";
+        case CsvStatus::UNKNOWN_ACTION: return "unknown action";
+        case CsvStatus::UNEXPECTED_SYMBOL: return "symbol column outside --symbols/--sharded";
+    }
+    return "unknown";
+}
+
+std::size_t splitCsvFields(std::string_view line, CsvFields& fields) {
+    std::size_t count = 0;
+    const char* cursor = line.data();
+    const char* end = line.data() + line.size();
+
+    while (count < CSV_MAX_FIELDS) {
+        const char* comma = static_cast<const char*>(std::memchr(cursor, ',', end - cursor));
+        const char* fieldEnd = comma ? comma : end;
+        fields[count++] = std::string_view(cursor, fieldEnd - cursor);
+        if (!comma || comma + 1 == end) {
+            break; // Last field, or a trailing comma that opens no further field
         }
-        return static_cast<T>(val);
+        cursor = comma + 1;
     }
-    // Fallback for other types
-    return static_cast<T>(std::stoll(str));
+    return count;
 }
 
-void processCsvFile(const std::string& filename, OrderBook& orderBook) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << filename << std::endl;
-        return;
+CsvParseResult decodeCsvFields(std::string_view line, const CsvFields& fields, std::size_t fieldCount,
+                               OrderCommand& command) {
+    if (line.empty() || line[0] == '#') {
+        return {CsvStatus::SKIPPED, 0};
     }
 
-    std::string line;
-    int lineNumber = 0;
-    int totalTrades = 0;
+    auto offsetOf = [&line](std::string_view field) {
+        return static_cast<std::size_t>(field.data() - line.data());
+    };
 
-    std::cout << "Processing CSV file: " << filename << "\n";
-    std::cout << "=================================================\n";
+    // Action and order id are required for every operation
+    if (fieldCount < 2) {
+        return {CsvStatus::MISSING_FIELD, line.size()};
+    }
 
-    while (std::getline(file, line)) {
-        lineNumber++;
+    command = OrderCommand{}; // CANCEL rows leave the order fields zero rather than the previous row's
+
+    std::string_view action = fields[0];
+    if (action == "CREATE") {
+        command.action_ = OrderAction::CREATE;
+    } else if (action == "MODIFY") {
+        command.action_ = OrderAction::MODIFY;
+    } else if (action == "CANCEL") {
+        command.action_ = OrderAction::CANCEL;
+    } else if (fieldCount < CSV_ORDER_FIELDS) {
+        // Unrecognised actions are held to the full row layout before being reported
+        return {CsvStatus::MISSING_FIELD, line.size()};
+    } else {
+        return {CsvStatus::UNKNOWN_ACTION, 0};
+    }
 
-        // Skip empty lines and comments
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
+    // For CANCEL operations, we only need action and order_id
+    if (command.action_ != OrderAction::CANCEL && fieldCount < CSV_ORDER_FIELDS) {
+        return {CsvStatus::MISSING_FIELD, line.size()};
+    }
+
+    if (!parseCsvNumber(fields[1], command.orderId_)) {
+        return {CsvStatus::INVALID_NUMBER, offsetOf(fields[1])};
+    }
+
+    // Optional timestamp column (CANCEL rows pad the unused order fields to reach it)
+    if (fieldCount > CSV_TIMESTAMP_FIELD && !parseCsvNumber(fields[CSV_TIMESTAMP_FIELD], command.timestamp_)) {
+        return {CsvStatus::INVALID_NUMBER, offsetOf(fields[CSV_TIMESTAMP_FIELD])};
+    }
+
+    if (command.action_ == OrderAction::CANCEL) {
+        return {CsvStatus::OK, 0};
+    }
+
+    command.side_ = (fields[2] == "BUY") ? OrderSide::BUY : OrderSide::SELL;
+    command.type_ = (fields[3] == "GTC") ? OrderType::GTC : OrderType::FOK;
+
+    if (!parseCsvNumber(fields[4], command.price_)) {
+        return {CsvStatus::INVALID_NUMBER, offsetOf(fields[4])};
+    }
+    if (!parseCsvNumber(fields[5], command.quantity_)) {
+        return {CsvStatus::INVALID_NUMBER, offsetOf(fields[5])};
+    }
+    return {CsvStatus::OK, 0};
+}
 
-        std::stringstream ss(line);
-        std::string action, orderIdStr, side, type, priceStr, quantityStr;
+std::size_t stripCsvSymbol(CsvFields& fields, std::size_t fieldCount, std::string_view& symbol) {
+    auto isAction = [](std::string_view field) {
+        return field == "CREATE" || field == "MODIFY" || field == "CANCEL";
+    };
 
-        // Parse CSV: action,order_id,side,type,price,quantity
-        if (!std::getline(ss, action, ',') ||
-            !std::getline(ss, orderIdStr, ',')) {
-            std::cerr << "Error parsing line " << lineNumber << ": " << line << std::endl;
+    symbol = std::string_view();
+    if (fieldCount < 2 || isAction(fields[0]) || !isAction(fields[1])) {
+        return fieldCount;
+    }
+    symbol = fields[0];
+    for (std::size_t i = 1; i < fieldCount; ++i) {
+        fields[i - 1] = fields[i];
+    }
+    return fieldCount - 1;
+}
+
+CsvParseResult parseCsvLine(std::string_view line, OrderCommand& command) {
+    CsvFields fields;
+    std::size_t fieldCount = line.empty() ? 0 : splitCsvFields(line, fields);
+    std::string_view symbol;
+    fieldCount = stripCsvSymbol(fields, fieldCount, symbol);
+    if (!symbol.empty()) {
+        return {CsvStatus::UNEXPECTED_SYMBOL, 0};
+    }
+    return decodeCsvFields(line, fields, fieldCount, command);
+}
+
+CsvCommandReader::CsvCommandReader(std::string_view data, int firstLineNumber, std::size_t baseOffset)
+    : data_(data), lineNumber_(firstLineNumber), baseOffset_(baseOffset) {}
+
+bool CsvCommandReader::next(OrderCommand& command) {
+    while (true) {
+        if (lineIndex_ == lines_.size()) {
+            blockStart_ += blockConsumed_;
+            if (blockStart_ >= data_.size()) {
+                return false;
+            }
+
+            std::size_t blockSize = std::min(blockBytes_, data_.size() - blockStart_);
+            bool finalBlock = blockStart_ + blockSize == data_.size();
+            blockConsumed_ = tokenizer_.tokenize(data_.substr(blockStart_, blockSize), finalBlock, lines_);
+            lineIndex_ = 0;
+
+            // A single line longer than the block - widen until it fits
+            blockBytes_ = blockConsumed_ == 0 ? blockBytes_ * 2 : CSV_BLOCK_BYTES;
             continue;
         }
 
-        // For CANCEL operations, we only need action and order_id
-        if (action != "CANCEL") {
-            if (!std::getline(ss, side, ',') ||
-                !std::getline(ss, type, ',') ||
-                !std::getline(ss, priceStr, ',') ||
-                !std::getline(ss, quantityStr, ',')) {
-                std::cerr << "Error parsing line " << lineNumber << ": " << line << std::endl;
-                continue;
-            }
+        const CsvLineTokens& tokens = lines_[lineIndex_++];
+        lineNumber_++;
+        lineOffset_ = baseOffset_ + blockStart_ + tokens.offset_;
+
+        std::string_view line;
+        CsvFields fields;
+        csvLineFields(data_.substr(blockStart_), tokens, line, fields);
+
+        std::size_t fieldCount = stripCsvSymbol(fields, tokens.fieldCount_, symbol_);
+        CsvParseResult result = (symbol_.empty() || acceptSymbols_)
+            ? decodeCsvFields(line, fields, fieldCount, command)
+            : CsvParseResult{CsvStatus::UNEXPECTED_SYMBOL, 0};
+        switch (result.status_) {
+            case CsvStatus::OK:
+                return true;
+            case CsvStatus::SKIPPED:
+                break;
+            case CsvStatus::UNKNOWN_ACTION:
+                std::cerr << "Unknown action '" << fields[0] << "' on line " << lineNumber_
+                          << " (byte " << lineOffset_ << ")" << std::endl;
+                break;
+            default:
+                std::cerr << "Error parsing line " << lineNumber_ << " at byte " << lineOffset_ + result.errorOffset_
+                          << " (" << csvStatusName(result.status_) << "): " << line << std::endl;
+                break;
         }
+    }
+}
+
+void processCsvFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return;
+    }
+
+    CsvCommandReader reader(file.data());
+    OrderCommand command;
+    int totalTrades = 0;
+
+    std::cout << "Processing CSV file: " << filename << "\n";
+    std::cout << "=================================================\n";
 
+    while (reader.next(command)) {
         try {
-            // Use range-checked conversion to prevent silent truncation
-            OrderId orderId = safeStringToNumber<OrderId>(orderIdStr);
-
-            // Lambda functions for enum parsing
-            auto parseOrderSide = [](const std::string& side) {
-                return (side == "BUY") ? OrderSide::BUY : OrderSide::SELL;
-            };
-            
-            auto parseOrderType = [](const std::string& type) {
-                return (type == "GTC") ? OrderType::GTC : OrderType::FOK;
-            };
-
-            if (action == "CREATE") {
-                OrderSide orderSide = parseOrderSide(side);
-                OrderType orderType = parseOrderType(type);
-                Price price(safeStringToNumber<std::int32_t>(priceStr));
-                Quantity quantity(safeStringToNumber<std::uint32_t>(quantityStr));
-
-                auto order = std::make_shared<Order>(orderId, orderSide, orderType, price, quantity);
-                auto trades = orderBook.addOrder(order);
-                totalTrades += trades.size();
-
-            } else if (action == "MODIFY") {
-                OrderSide orderSide = parseOrderSide(side);
-                OrderType orderType = parseOrderType(type);
-                Price price(safeStringToNumber<std::int32_t>(priceStr));
-                Quantity quantity(safeStringToNumber<std::uint32_t>(quantityStr));
-
-                OrderModifier modifier(orderId, orderSide, orderType, price, quantity);
-                auto trades = orderBook.matchOrder(modifier);
-                totalTrades += trades.size();
-
-            } else if (action == "CANCEL") {
-                orderBook.cancelOrder(orderId);
-
-            } else {
-                std::cerr << "Unknown action '" << action << "' on line " << lineNumber << std::endl;
+            Trades trades = applyOrderCommand(orderBook, command);
+            totalTrades += trades.size();
+            if (tape) {
+                tape->record(trades);
+                tape->commit();
             }
-
         } catch (const std::exception& e) {
-            std::cerr << "Error processing line " << lineNumber << ": " << e.what() << std::endl;
+            std::cerr << "Error processing line " << reader.getLineNumber() << " (byte " << reader.getLineOffset()
+                      << "): " << e.what() << std::endl;
         }
     }
 
     std::cout << "=================================================\n";
     std::cout << "CSV Processing Complete!\n";
-    std::cout << "Lines processed: " << lineNumber << "\n";
+    std::cout << "Lines processed: " << reader.getLineNumber() << "\n";
     std::cout << "Total trades executed: " << totalTrades << "\n";
     std::cout << "Final order book size: " << orderBook.getSize() << " orders\n";
-
-    file.close();
 }
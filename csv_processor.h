@@ -6,20 +6,185 @@
 #pragma once
 
 #include "orderbook.h"
+#include "order_command.h"
+#include "csv_tokenizer.h"  // CsvFields and block delimiter scanning
+#include "trade_tape.h"     // Optional trade output
+#include <charconv>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**
- * Safely convert string to numeric type with range checking
- * @param str String to convert
- * @return Converted value
- * @throws std::out_of_range if value exceeds type limits
+ * Bytes of input tokenized per block (lines longer than this widen the block)
+ */
+constexpr std::size_t CSV_BLOCK_BYTES = 1 << 20;
+
+/**
+ * Outcome of decoding one CSV line
+ */
+enum class CsvStatus
+{
+    OK,             // command decoded
+    SKIPPED,        // empty or comment line
+    MISSING_FIELD,  // fewer fields than the action requires
+    INVALID_NUMBER, // numeric field malformed or out of range
+    UNKNOWN_ACTION, // action is not CREATE, MODIFY or CANCEL
+    UNEXPECTED_SYMBOL // symbol column on a line read into a single book
+};
+
+/**
+ * Result of decoding one CSV line
+ */
+struct CsvParseResult
+{
+    CsvStatus status_;        // Outcome
+    std::size_t errorOffset_; // Byte offset within the line of the offending field (0 on success)
+};
+
+/**
+ * Human readable description of a decode status
+ * @param status Status to describe
+ * @return Static string
+ */
+const char* csvStatusName(CsvStatus status);
+
+/**
+ * Parse a numeric CSV field without allocating or consulting the locale
+ * Surrounding spaces/tabs are ignored; anything else that is not part of the number is an error
+ * @param field Field text
+ * @param value Receives the parsed value on success
+ * @return true if the whole field is a number within T's range
  */
 template<typename T>
-T safeStringToNumber(const std::string& str);
+bool parseCsvNumber(std::string_view field, T& value) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) {
+        field.remove_prefix(1);
+    }
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t')) {
+        field.remove_suffix(1);
+    }
+    const char* end = field.data() + field.size();
+    auto [ptr, ec] = std::from_chars(field.data(), end, value);
+    return ec == std::errc() && ptr == end && !field.empty();
+}
+
+/**
+ * Strip the line terminator left on a line (a trailing carriage return from CRLF files)
+ * @param line Line without its '\n'
+ * @return Line without a trailing '\r'
+ */
+inline std::string_view trimCsvLine(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+/**
+ * Split a line into comma separated fields
+ * A trailing empty field (line ending in a comma) is not counted, and fields past
+ * CSV_MAX_FIELDS are ignored
+ * @param line Line without its terminator
+ * @param fields Receives views into line
+ * @return Number of fields found
+ */
+std::size_t splitCsvFields(std::string_view line, CsvFields& fields);
+
+/**
+ * Decode already split fields into an order command
+ * @param line Line the fields point into (used to compute error offsets)
+ * @param fields Field views produced by a tokenizer
+ * @param fieldCount Number of valid entries in fields
+ * @param command Receives the decoded command when the status is OK
+ * @return Decode status and error offset
+ */
+CsvParseResult decodeCsvFields(std::string_view line, const CsvFields& fields, std::size_t fieldCount,
+                               OrderCommand& command);
+
+/**
+ * Remove a leading symbol column from split fields
+ * A line carries a symbol when its first field is not an action but its second field is
+ * @param fields Field views; shifted left by one when a symbol is present
+ * @param fieldCount Number of valid entries in fields
+ * @param symbol Receives the symbol, or an empty view when the line has none
+ * @return Number of fields left for decodeCsvFields
+ */
+std::size_t stripCsvSymbol(CsvFields& fields, std::size_t fieldCount, std::string_view& symbol);
+
+/**
+ * Split and decode one CSV line for a single book
+ * A line with a leading symbol column is rejected, since its symbol would be ignored
+ * @param line Line without its '\n'
+ * @param command Receives the decoded command when the status is OK
+ * @return Decode status and error offset
+ */
+CsvParseResult parseCsvLine(std::string_view line, OrderCommand& command);
+
+/**
+ * Pull-style reader that turns CSV text into order commands
+ * Tokenizes a block at a time and decodes lines in place; malformed lines are reported
+ * to stderr with their line number and byte offset and skipped. Lines with a symbol column
+ * are treated as malformed unless the reader feeds a multi-symbol mode (setAcceptSymbols).
+ */
+class CsvCommandReader
+{
+    public:
+    /**
+     * Create a reader over CSV text
+     * @param data Complete lines of input (must outlive the reader)
+     * @param firstLineNumber Lines already read before data (for error reporting)
+     * @param baseOffset Byte offset of data within the whole input (for error reporting)
+     */
+    explicit CsvCommandReader(std::string_view data, int firstLineNumber = 0, std::size_t baseOffset = 0);
+
+    /**
+     * Decode the next valid command
+     * @param command Receives the command
+     * @return false once the input is exhausted
+     */
+    bool next(OrderCommand& command);
+
+    /**
+     * Line number of the last line read (1-based, counting comments and blank lines)
+     */
+    int getLineNumber() const { return lineNumber_; }
+
+    /**
+     * Byte offset of the last line read from the start of the input
+     */
+    std::size_t getLineOffset() const { return lineOffset_; }
+
+    /**
+     * Symbol column of the last command read (empty when the line has none)
+     */
+    std::string_view getSymbol() const { return symbol_; }
+
+    /**
+     * Choose whether lines may carry a symbol column (off by default)
+     * @param accept true for readers that route by symbol; otherwise symbol lines are reported and skipped
+     */
+    void setAcceptSymbols(bool accept) { acceptSymbols_ = accept; }
+
+    private:
+    std::string_view data_;              // Whole input
+    CsvTokenizer tokenizer_;             // Delimiter scanner
+    std::vector<CsvLineTokens> lines_;   // Lines of the current block
+    std::size_t lineIndex_ = 0;          // Next line of the current block to decode
+    std::size_t blockStart_ = 0;         // Offset of the current block
+    std::size_t blockConsumed_ = 0;      // Bytes of the current block covered by lines_
+    std::size_t blockBytes_ = CSV_BLOCK_BYTES; // Size of the next block
+    int lineNumber_ = 0;                 // Lines read so far
+    std::size_t lineOffset_ = 0;         // Offset of the last line read
+    std::string_view symbol_;            // Symbol of the last line read
+    bool acceptSymbols_ = false;         // Symbol lines are decoded rather than rejected
+    std::size_t baseOffset_;             // Offset of data within the whole input
+};
 
 /**
  * Process CSV file containing order operations
+ * The file is memory-mapped, tokenized a block at a time and decoded in place - no per-line allocation in the parser
  * @param filename Path to CSV file
  * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade (committed after each command)
  */
-void processCsvFile(const std::string& filename, OrderBook& orderBook);
+void processCsvFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape = nullptr);
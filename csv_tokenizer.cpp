@@ -0,0 +1,357 @@
+/**
+ * CSV Tokenizer Implementation
+ * Scalar, SSE2 and AVX2 delimiter scanners sharing one line builder
+ */
+
+#include "csv_tokenizer.h"
+#include "csv_processor.h"  // Reference splitter for the differential check
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>          // Original getline parser for the differential check
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CSV_TOKENIZER_X86 1
+#endif
+
+namespace {
+
+/**
+ * Turns the ordered stream of delimiter positions into per-line field boundaries
+ * Mirrors splitCsvFields: at most CSV_MAX_FIELDS fields, and a trailing comma opens no field
+ */
+class LineBuilder
+{
+    public:
+    LineBuilder(const char* block, std::vector<CsvLineTokens>& lines) : block_(block), lines_(lines) {
+        begin(0);
+    }
+
+    void comma(std::uint32_t position) {
+        if (current_.fieldCount_ < CSV_MAX_FIELDS) {
+            current_.fieldEnds_[current_.fieldCount_ - 1] = position;
+            current_.fieldCount_++;
+            fieldStart_ = position + 1;
+        } else if (!lastFieldClosed_) {
+            current_.fieldEnds_[CSV_MAX_FIELDS - 1] = position; // Everything past the last field is ignored
+            lastFieldClosed_ = true;
+        }
+    }
+
+    void newline(std::uint32_t position) {
+        std::uint32_t end = position;
+        if (end > current_.offset_ && block_[end - 1] == '\r') {
+            end--;
+        }
+        current_.length_ = end - current_.offset_;
+
+        if (current_.length_ == 0) {
+            current_.fieldCount_ = 0;
+        } else if (!lastFieldClosed_) {
+            if (current_.fieldCount_ > 1 && fieldStart_ == end) {
+                current_.fieldCount_--; // Trailing comma - the previous field already has its end
+            } else {
+                current_.fieldEnds_[current_.fieldCount_ - 1] = end;
+            }
+        }
+
+        lines_.push_back(current_);
+        begin(position + 1);
+    }
+
+    std::uint32_t lineStart() const { return current_.offset_; }
+
+    private:
+    void begin(std::uint32_t offset) {
+        current_.offset_ = offset;
+        current_.fieldCount_ = 1;
+        fieldStart_ = offset;
+        lastFieldClosed_ = false;
+    }
+
+    const char* block_;
+    std::vector<CsvLineTokens>& lines_;
+    CsvLineTokens current_;
+    std::uint32_t fieldStart_;
+    bool lastFieldClosed_;
+};
+
+inline void dispatchDelimiter(const char* data, std::uint32_t position, LineBuilder& builder) {
+    if (data[position] == ',') {
+        builder.comma(position);
+    } else {
+        builder.newline(position);
+    }
+}
+
+void scanScalar(const char* data, std::size_t begin, std::size_t size, LineBuilder& builder) {
+    for (std::size_t i = begin; i < size; ++i) {
+        if (data[i] == ',' || data[i] == '\n') {
+            dispatchDelimiter(data, static_cast<std::uint32_t>(i), builder);
+        }
+    }
+}
+
+#ifdef CSV_TOKENIZER_X86
+void scanSse2(const char* data, std::size_t size, LineBuilder& builder) {
+    const __m128i commas = _mm_set1_epi8(',');
+    const __m128i newlines = _mm_set1_epi8('\n');
+    std::size_t i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, commas), _mm_cmpeq_epi8(chunk, newlines))));
+        while (mask != 0) {
+            dispatchDelimiter(data, static_cast<std::uint32_t>(i + __builtin_ctz(mask)), builder);
+            mask &= mask - 1;
+        }
+    }
+    scanScalar(data, i, size, builder);
+}
+
+__attribute__((target("avx2")))
+void scanAvx2(const char* data, std::size_t size, LineBuilder& builder) {
+    const __m256i commas = _mm256_set1_epi8(',');
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    std::size_t i = 0;
+
+    for (; i + 64 <= size; i += 64) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        std::uint32_t lowMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(low, commas), _mm256_cmpeq_epi8(low, newlines))));
+        std::uint32_t highMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(high, commas), _mm256_cmpeq_epi8(high, newlines))));
+        std::uint64_t mask = lowMask | (static_cast<std::uint64_t>(highMask) << 32);
+        while (mask != 0) {
+            dispatchDelimiter(data, static_cast<std::uint32_t>(i + __builtin_ctzll(mask)), builder);
+            mask &= mask - 1;
+        }
+    }
+    scanScalar(data, i, size, builder);
+}
+#endif
+
+/**
+ * Fields of a line as the original getline/stringstream parser read them
+ * Empty fields are kept, a trailing comma opens no field, and reading stops after
+ * CSV_MAX_FIELDS fields. A trailing '\r' is dropped from the line first: the original parser
+ * left it on the last field, where only the number conversion happened to ignore it.
+ * @param line Line as std::getline returned it
+ * @param fields Receives the field text
+ * @return Number of fields read
+ */
+std::size_t getlineFields(std::string line, std::array<std::string, CSV_MAX_FIELDS>& fields) {
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    std::stringstream ss(line);
+    std::size_t count = 0;
+    while (count < CSV_MAX_FIELDS && std::getline(ss, fields[count], ',')) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Small documents covering the inputs the test files never contain
+ * Quotes carry no meaning to either parser, so a quoted comma still splits the field
+ */
+std::vector<std::string> csvEdgeCases() {
+    return {
+        "CREATE,1,BUY,GTC,100,10\r\nCANCEL,1\r\n\r\n#comment\r\nMODIFY,2,SELL,FOK,101,5",
+        "\"CREATE\",\"3\",BUY,GTC,100,10\nCREATE,4,\"BUY,SELL\",GTC,\"\",10\n\"\"\n",
+        ",,,,,\nCREATE,,BUY,,100,\n,\n,,\nCANCEL,5,\nAAPL,CREATE,6,BUY,GTC,100,10,123,extra,more\n",
+        "\n\n\r\n\r\r\n",
+        "CANCEL,7",
+        "",
+        "CREATE,8,BUY,GTC,100," + std::string(10000, '9') + "\r\nCANCEL,8",
+    };
+}
+
+/**
+ * Tokenize a document with one kernel in small blocks and compare every line against the
+ * reference splitter (same views) and the original getline parser (same text)
+ * @param kernel Kernel to check
+ * @param data Document text
+ * @param original The same document, read line by line as the original parser did
+ * @param source Document name for the mismatch report
+ * @param lineCount Receives the number of lines compared
+ * @return true if every line matches and both references end with the tokenizer
+ */
+bool checkKernel(CsvTokenizerKernel kernel, std::string_view data, std::istream& original, const std::string& source,
+                 std::size_t& lineCount) {
+    const char* name = CsvTokenizer::kernelName(kernel);
+    CsvTokenizer tokenizer(kernel);
+    std::vector<CsvLineTokens> lines;
+    std::size_t blockStart = 0;
+    std::size_t blockBytes = 4096; // Small blocks so that many lines straddle a block boundary
+    std::size_t referenceStart = 0;
+    std::string originalLine;
+    std::array<std::string, CSV_MAX_FIELDS> originalFields;
+    lineCount = 0;
+
+    while (blockStart < data.size()) {
+        std::size_t blockSize = std::min(blockBytes, data.size() - blockStart);
+        bool finalBlock = blockStart + blockSize == data.size();
+        std::string_view block = data.substr(blockStart, blockSize);
+        std::size_t consumed = tokenizer.tokenize(block, finalBlock, lines);
+        if (consumed == 0) {
+            blockBytes *= 2;
+            continue;
+        }
+
+        for (const CsvLineTokens& tokens : lines) {
+            lineCount++;
+
+            // Reference split, exactly as processCsvFile did before block tokenizing
+            std::size_t referenceEnd = data.find('\n', referenceStart);
+            if (referenceEnd == std::string_view::npos) {
+                referenceEnd = data.size();
+            }
+            std::string_view expectedLine = trimCsvLine(data.substr(referenceStart, referenceEnd - referenceStart));
+            referenceStart = referenceEnd + 1;
+            CsvFields expected;
+            std::size_t expectedCount = expectedLine.empty() ? 0 : splitCsvFields(expectedLine, expected);
+
+            std::string_view line;
+            CsvFields fields;
+            csvLineFields(block, tokens, line, fields);
+
+            bool same = line == expectedLine && line.data() == expectedLine.data() &&
+                        tokens.fieldCount_ == expectedCount;
+            for (std::size_t i = 0; same && i < expectedCount; ++i) {
+                same = fields[i].data() == expected[i].data() && fields[i].size() == expected[i].size();
+            }
+
+            // Field text as the original parser produced it
+            same = same && std::getline(original, originalLine) &&
+                   getlineFields(originalLine, originalFields) == tokens.fieldCount_;
+            for (std::size_t i = 0; same && i < tokens.fieldCount_; ++i) {
+                same = fields[i] == originalFields[i];
+            }
+            if (!same) {
+                std::cout << "[TOKENIZER] " << name << ": mismatch on line " << lineCount << " of " << source
+                          << ": " << expectedLine << "\n";
+                return false;
+            }
+        }
+        blockStart += consumed;
+    }
+
+    if (referenceStart < data.size() || std::getline(original, originalLine)) {
+        std::cout << "[TOKENIZER] " << name << ": stopped after line " << lineCount << " of " << source
+                  << " before the references did\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+CsvTokenizer::CsvTokenizer(CsvTokenizerKernel kernel) : kernel_(kernel) {
+    if (kernel_ == CsvTokenizerKernel::BEST || !isSupported(kernel_)) {
+        kernel_ = isSupported(CsvTokenizerKernel::AVX2) ? CsvTokenizerKernel::AVX2
+                : isSupported(CsvTokenizerKernel::SSE2) ? CsvTokenizerKernel::SSE2
+                : CsvTokenizerKernel::SCALAR;
+    }
+}
+
+const char* CsvTokenizer::kernelName(CsvTokenizerKernel kernel) {
+    switch (kernel) {
+        case CsvTokenizerKernel::SCALAR: return "scalar";
+        case CsvTokenizerKernel::SSE2: return "sse2";
+        case CsvTokenizerKernel::AVX2: return "avx2";
+        case CsvTokenizerKernel::BEST: return "best";
+    }
+    return "unknown";
+}
+
+bool CsvTokenizer::isSupported(CsvTokenizerKernel kernel) {
+    switch (kernel) {
+        case CsvTokenizerKernel::SCALAR:
+            return true;
+#ifdef CSV_TOKENIZER_X86
+        case CsvTokenizerKernel::SSE2:
+            return true;
+        case CsvTokenizerKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+std::size_t CsvTokenizer::tokenize(std::string_view block, bool finalBlock, std::vector<CsvLineTokens>& lines) const {
+    lines.clear();
+    LineBuilder builder(block.data(), lines);
+
+    switch (kernel_) {
+#ifdef CSV_TOKENIZER_X86
+        case CsvTokenizerKernel::AVX2:
+            scanAvx2(block.data(), block.size(), builder);
+            break;
+        case CsvTokenizerKernel::SSE2:
+            scanSse2(block.data(), block.size(), builder);
+            break;
+#endif
+        default:
+            scanScalar(block.data(), 0, block.size(), builder);
+            break;
+    }
+
+    std::size_t consumed = builder.lineStart();
+    if (finalBlock && consumed < block.size()) {
+        builder.newline(static_cast<std::uint32_t>(block.size())); // Unterminated last line
+        consumed = block.size();
+    }
+    return consumed;
+}
+
+bool checkCsvTokenizer(const std::string& filename) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return false;
+    }
+
+    const CsvTokenizerKernel kernels[] = {CsvTokenizerKernel::SCALAR, CsvTokenizerKernel::SSE2, CsvTokenizerKernel::AVX2};
+    const std::vector<std::string> edgeCases = csvEdgeCases();
+    bool allMatch = true;
+
+    for (CsvTokenizerKernel kernel : kernels) {
+        const char* name = CsvTokenizer::kernelName(kernel);
+        if (!CsvTokenizer::isSupported(kernel)) {
+            std::cout << "[TOKENIZER] " << name << ": not supported on this CPU, skipped\n";
+            continue;
+        }
+
+        std::size_t edgeLines = 0;
+        bool kernelMatches = true;
+        for (std::size_t i = 0; kernelMatches && i < edgeCases.size(); ++i) {
+            std::istringstream original(edgeCases[i]);
+            std::size_t lines = 0;
+            kernelMatches = checkKernel(kernel, edgeCases[i], original, "edge case " + std::to_string(i + 1), lines);
+            edgeLines += lines;
+        }
+        if (kernelMatches) {
+            std::cout << "[TOKENIZER] " << name << ": " << edgeCases.size() << " edge case(s), " << edgeLines
+                      << " line(s) match\n";
+        }
+
+        std::ifstream original(filename, std::ios::binary);
+        std::size_t fileLines = 0;
+        if (kernelMatches && checkKernel(kernel, file.data(), original, filename, fileLines)) {
+            std::cout << "[TOKENIZER] " << name << ": " << fileLines
+                      << " line(s) match the reference splitter and the original getline parser\n";
+        } else {
+            kernelMatches = false;
+        }
+        allMatch = allMatch && kernelMatches;
+    }
+    return allMatch;
+}
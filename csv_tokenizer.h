@@ -0,0 +1,118 @@
+/**
+ * CSV Tokenizer Module
+ * Block tokenizer that locates commas and newlines with SIMD compares and records
+ * field boundaries for many lines at once
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Fields read from one CSV line
+ * Layout: [symbol,]action,order_id,side,type,price,quantity[,timestamp] - anything after the timestamp is ignored
+ * Field indices below are counted after the optional symbol column is removed (see stripCsvSymbol)
+ */
+constexpr std::size_t CSV_ORDER_FIELDS = 6;      // Required for CREATE/MODIFY
+constexpr std::size_t CSV_TIMESTAMP_FIELD = 6;   // Optional event time in nanoseconds
+constexpr std::size_t CSV_MAX_FIELDS = 8;        // Symbol, order fields and timestamp
+
+using CsvFields = std::array<std::string_view, CSV_MAX_FIELDS>;
+
+/**
+ * Field boundaries of one line inside a tokenized block
+ * Offsets are relative to the start of the block passed to CsvTokenizer::tokenize
+ */
+struct CsvLineTokens
+{
+    std::uint32_t offset_;                                // Start of the line
+    std::uint32_t length_;                                // Length without '\n' and trailing '\r'
+    std::uint32_t fieldCount_;                            // Number of fields (0 for an empty line)
+    std::array<std::uint32_t, CSV_MAX_FIELDS> fieldEnds_; // End of each field; field i starts after fieldEnds_[i - 1]
+};
+
+/**
+ * Delimiter scanning implementation
+ */
+enum class CsvTokenizerKernel
+{
+    SCALAR, // byte at a time
+    SSE2,   // 16 bytes per compare (baseline on x86-64)
+    AVX2,   // 64 bytes per iteration using two 32 byte compares
+    BEST    // fastest kernel the running CPU supports
+};
+
+/**
+ * Splits blocks of CSV text into per-line field boundaries
+ * Produces exactly the fields splitCsvFields would for each line, so the output can be
+ * fed straight into decodeCsvFields
+ */
+class CsvTokenizer
+{
+    public:
+    /**
+     * Create a tokenizer
+     * @param kernel Scanning kernel; BEST (or a kernel the CPU lacks) selects the best available via CPUID
+     */
+    explicit CsvTokenizer(CsvTokenizerKernel kernel = CsvTokenizerKernel::BEST);
+
+    /**
+     * Tokenize the complete lines of a block
+     * @param block Text to scan (must be smaller than 4 GiB)
+     * @param finalBlock true if no more data follows, so an unterminated last line is complete
+     * @param lines Cleared and filled with one entry per line (capacity is reused across calls)
+     * @return Bytes consumed - the start of the first incomplete line, or block.size() for a final block
+     */
+    std::size_t tokenize(std::string_view block, bool finalBlock, std::vector<CsvLineTokens>& lines) const;
+
+    /**
+     * Kernel actually in use
+     * @return SCALAR, SSE2 or AVX2
+     */
+    CsvTokenizerKernel getKernel() const { return kernel_; }
+
+    /**
+     * Kernel name for diagnostics
+     * @param kernel Kernel to name
+     * @return Static string
+     */
+    static const char* kernelName(CsvTokenizerKernel kernel);
+
+    /**
+     * Check whether the running CPU can execute a kernel
+     * @param kernel Kernel to check
+     * @return true if the kernel can be used
+     */
+    static bool isSupported(CsvTokenizerKernel kernel);
+
+    private:
+    CsvTokenizerKernel kernel_; // Resolved scanning kernel
+};
+
+/**
+ * Rebuild field views for a tokenized line
+ * @param block Block the line was tokenized from
+ * @param tokens Line boundaries
+ * @param line Receives the line text
+ * @param fields Receives the field views
+ */
+inline void csvLineFields(std::string_view block, const CsvLineTokens& tokens, std::string_view& line, CsvFields& fields) {
+    line = block.substr(tokens.offset_, tokens.length_);
+    std::uint32_t start = tokens.offset_;
+    for (std::uint32_t i = 0; i < tokens.fieldCount_; ++i) {
+        fields[i] = block.substr(start, tokens.fieldEnds_[i] - start);
+        start = tokens.fieldEnds_[i] + 1;
+    }
+}
+
+/**
+ * Compare every available tokenizer kernel against splitCsvFields and the original
+ * getline/stringstream parser, on built-in edge cases and then on a file
+ * @param filename Path to CSV file
+ * @return true if all kernels agree on every line
+ */
+bool checkCsvTokenizer(const std::string& filename);
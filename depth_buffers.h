@@ -0,0 +1,153 @@
+/**
+ * Depth Buffers Module
+ * Multi-buffered L2 depth maintained incrementally by one writer and copied by lock-free readers
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>       // Front index and per-buffer reader counts
+#include <cstdint>
+#include <vector>
+#include "spsc_ring.h"  // CACHE_LINE_SIZE
+
+constexpr std::size_t DEPTH_BUFFER_COUNT = 3;   // Front plus two back buffers
+constexpr std::size_t DEPTH_STALE_LIMIT = 1024; // Changed prices a buffer tracks before falling back to a rebuild
+
+/**
+ * Aggregated quantity at one price
+ */
+struct DepthLevel
+{
+    std::int32_t price_;
+    std::uint64_t quantity_;  // Remaining quantity of every order at this price (never 0)
+};
+
+/**
+ * Full-depth view of both sides
+ * Readers keep one and refill it, so a snapshot only allocates when the book grows past
+ * the deepest snapshot taken so far.
+ */
+struct DepthSnapshot
+{
+    std::vector<DepthLevel> bids_;  // Highest price first
+    std::vector<DepthLevel> asks_;  // Lowest price first
+    std::uint64_t sequence_ = 0;    // Book state change this depth reflects
+};
+
+/**
+ * N-buffered depth with a single writer and any number of readers
+ * The writer refreshes a back buffer that no reader holds, applying only the prices changed
+ * since that buffer was last written, then flips the front index. A reader registers on the
+ * front buffer, confirms it is still the front and copies it. The writer only picks a buffer
+ * whose reader count it sees as zero after flipping away from it, and a reader that registers
+ * afterwards sees the flip and backs off, so a buffer is never written while being copied.
+ * If every back buffer is held, the publish is deferred; the changes stay recorded.
+ */
+class DepthBuffers
+{
+    public:
+    /**
+     * Writer-side state of one buffer
+     */
+    struct Buffer
+    {
+        DepthSnapshot depth_;
+        std::vector<std::int32_t> staleBids_;  // Bid prices changed since this buffer was written
+        std::vector<std::int32_t> staleAsks_;
+        bool rebuildBids_ = false;             // Stale list overflowed or a peg reference moved
+        bool rebuildAsks_ = false;
+        alignas(CACHE_LINE_SIZE) mutable std::atomic<unsigned> readers_{0};
+    };
+
+    DepthBuffers() = default;
+    DepthBuffers(const DepthBuffers&) = delete;
+    DepthBuffers& operator=(const DepthBuffers&) = delete;
+
+    /**
+     * Record that the quantity at a price changed (writer only)
+     * @param bid Side of the price
+     * @param price Changed level
+     */
+    void markDirty(bool bid, std::int32_t price) {
+        for (Buffer& buffer : buffers_) {
+            std::vector<std::int32_t>& stale = bid ? buffer.staleBids_ : buffer.staleAsks_;
+            bool& rebuild = bid ? buffer.rebuildBids_ : buffer.rebuildAsks_;
+            if (rebuild) {
+                continue;
+            }
+            if (stale.size() == DEPTH_STALE_LIMIT) {
+                stale.clear();
+                rebuild = true;
+            } else {
+                stale.push_back(price);
+            }
+        }
+    }
+
+    /**
+     * Make every buffer rebuild one side from scratch on its next refresh (writer only)
+     * @param bid Side to rebuild
+     */
+    void markRebuild(bool bid) {
+        for (Buffer& buffer : buffers_) {
+            (bid ? buffer.staleBids_ : buffer.staleAsks_).clear();
+            (bid ? buffer.rebuildBids_ : buffer.rebuildAsks_) = true;
+        }
+    }
+
+    /**
+     * Refresh a free back buffer and make it the front (writer only)
+     * @param sequence Book state change the depth reflects
+     * @param refresh Called as refresh(buffer) to bring the buffer's sides up to date from its
+     *                stale lists and rebuild flags
+     * @return false if every back buffer is being read (nothing was published)
+     */
+    template<typename Refresh>
+    bool publish(std::uint64_t sequence, Refresh refresh) {
+        std::size_t front = front_.load(std::memory_order_relaxed);
+        for (std::size_t step = 1; step < DEPTH_BUFFER_COUNT; ++step) {
+            std::size_t index = (front + step) % DEPTH_BUFFER_COUNT;
+            Buffer& buffer = buffers_[index];
+            if (buffer.readers_.load(std::memory_order_seq_cst) != 0) {
+                continue;
+            }
+            refresh(buffer);
+            buffer.staleBids_.clear();
+            buffer.staleAsks_.clear();
+            buffer.rebuildBids_ = false;
+            buffer.rebuildAsks_ = false;
+            buffer.depth_.sequence_ = sequence;
+            front_.store(index, std::memory_order_seq_cst);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Copy the front buffer; safe from any thread
+     * @param snapshot Receives the depth (its vectors are reused)
+     */
+    void read(DepthSnapshot& snapshot) const {
+        while (true) {
+            std::size_t index = front_.load(std::memory_order_seq_cst);
+            const Buffer& buffer = buffers_[index];
+            buffer.readers_.fetch_add(1, std::memory_order_seq_cst);
+            if (front_.load(std::memory_order_seq_cst) != index) {
+                // Flipped away before we registered; the writer may already be refreshing it
+                buffer.readers_.fetch_sub(1, std::memory_order_release);
+                cpuRelax();
+                continue;
+            }
+            snapshot.bids_.assign(buffer.depth_.bids_.begin(), buffer.depth_.bids_.end());
+            snapshot.asks_.assign(buffer.depth_.asks_.begin(), buffer.depth_.asks_.end());
+            snapshot.sequence_ = buffer.depth_.sequence_;
+            buffer.readers_.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+    }
+
+    private:
+    std::array<Buffer, DEPTH_BUFFER_COUNT> buffers_;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> front_{0};
+};
@@ -0,0 +1,88 @@
+/**
+ * FIX Order Entry Module
+ * Allocation-free FIX 4.4 subset parser for NewOrderSingle (D), OrderCancelRequest (F)
+ * and OrderCancelReplaceRequest (G)
+ *
+ * Tags read: 8 BeginString, 9 BodyLength, 35 MsgType, 11 ClOrdID, 41 OrigClOrdID, 54 Side,
+ * 38 OrderQty, 44 Price, 40 OrdType, 59 TimeInForce, 10 CheckSum. ClOrdIDs must be numeric
+ * and become engine order ids: D creates ClOrdID, F cancels OrigClOrdID and G modifies
+ * OrigClOrdID in place (the engine keeps one id per order across replaces).
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "order_command.h"
+#include "trade_tape.h"
+#include <string>
+#include <string_view>
+
+constexpr char FIX_SOH = '\x01';
+
+/**
+ * Outcome of parsing one FIX message
+ */
+enum class FixStatus
+{
+    OK,                  // command decoded
+    INCOMPLETE,          // buffer ends before the message does - read more and retry
+    BAD_BEGIN_STRING,    // does not start with 8=FIX.4.4
+    BAD_BODY_LENGTH,     // tag 9 missing/malformed or fields overrun it
+    BAD_CHECKSUM,        // tag 10 missing or does not match
+    MISSING_FIELD,       // a field the message type requires is absent
+    INVALID_FIELD,       // a field value is malformed or out of range
+    UNSUPPORTED          // message type, order type or time in force the engine cannot honour
+};
+
+/**
+ * Human readable description of a parse status
+ * @param status Status to describe
+ * @return Static string
+ */
+const char* fixStatusName(FixStatus status);
+
+/**
+ * Parse one message from the front of a buffer
+ * Scans the bytes once, accumulating the checksum while splitting tags, and writes only
+ * into the command - no strings or maps are created
+ * @param buffer Bytes starting at a message
+ * @param consumed Receives the message length (also on validation errors, so the caller can skip it)
+ * @param command Receives the decoded command when the status is OK
+ * @param priceDecimals Decimal places folded into integer engine prices (44=101.25 with 2 -> 10125)
+ * @return Parse status
+ */
+FixStatus parseFixMessage(std::string_view buffer, std::size_t& consumed, OrderCommand& command,
+                          unsigned priceDecimals = 0);
+
+/**
+ * Encode a command as a FIX message (for generating test flow, not on the hot path)
+ * @param command Command to encode
+ * @param sequenceNumber MsgSeqNum (tag 34)
+ * @param out Message is appended here
+ */
+void appendFixMessage(const OrderCommand& command, std::uint64_t sequenceNumber, std::string& out);
+
+/**
+ * Write a file of random FIX order flow for benchmarking
+ * @param filename Output path
+ * @param count Number of messages
+ * @return true if the file was written
+ */
+bool generateFixFile(const std::string& filename, std::uint64_t count);
+
+/**
+ * Replay a file of FIX messages against an order book
+ * Malformed messages are reported with their byte offset and skipped
+ * @param filename Path to FIX message file
+ * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade
+ * @return false if the file could not be read
+ */
+bool processFixFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape = nullptr);
+
+/**
+ * Measure parser throughput on a file, then parse-and-apply throughput with the engine log muted
+ * @param filename Path to FIX message file
+ * @return false if the file could not be read
+ */
+bool benchmarkFixFile(const std::string& filename);
@@ -0,0 +1,84 @@
+/**
+ * Latency Histogram Module
+ * Fixed-size log-linear histogram for nanosecond latencies
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Records latencies into 16 linear sub-buckets per power of two (under 6.25% relative error)
+ * Recording is a few instructions and never allocates, so it can sit on the measured path
+ */
+class LatencyHistogram
+{
+    public:
+    /**
+     * Record one latency
+     * @param nanos Latency in nanoseconds
+     */
+    void record(std::uint64_t nanos) {
+        counts_[bucketOf(nanos)]++;
+        count_++;
+        sum_ += nanos;
+        min_ = nanos < min_ ? nanos : min_;
+        max_ = nanos > max_ ? nanos : max_;
+    }
+
+    /**
+     * Latency at a percentile
+     * @param percentile Percentile in [0, 100]
+     * @return Lower bound of the bucket holding the percentile (0 if empty)
+     */
+    std::uint64_t percentile(double percentile) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(count_ - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += counts_[bucket];
+            if (seen >= rank) {
+                std::uint64_t lower = lowerBoundOf(bucket);
+                return lower < min_ ? min_ : (lower > max_ ? max_ : lower);
+            }
+        }
+        return max_;
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t min() const { return count_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    private:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr std::size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static std::size_t bucketOf(std::uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<std::size_t>(value);
+        }
+        unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));
+        std::size_t sub = static_cast<std::size_t>(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static std::uint64_t lowerBoundOf(std::size_t bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        unsigned exponent = static_cast<unsigned>(bucket / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+        return static_cast<std::uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - SUB_BUCKET_BITS);
+    }
+
+    std::array<std::uint64_t, BUCKETS> counts_{}; // Samples per bucket
+    std::uint64_t count_ = 0;                      // Total samples
+    std::uint64_t sum_ = 0;                        // Sum of samples
+    std::uint64_t min_ = std::numeric_limits<std::uint64_t>::max(); // Smallest sample
+    std::uint64_t max_ = 0;                        // Largest sample
+};
@@ -4,19 +4,313 @@
  */
 
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 #include "orderbook.h"
 #include "csv_processor.h"
+#include "csv_tokenizer.h"
+#include "constraint_check.h"
+#include "binary_events.h"
+#include "pipelined_replay.h"
+#include "market_data.h"
+#include "stream_processor.h"
+#include "trade_tape.h"
+#include "batch_replay.h"
+#include "paced_replay.h"
+#include "itch_decoder.h"
+#include "fix_parser.h"
+#include "tcp_gateway.h"
+#include "shm_transport.h"
+#include "async_reader.h"
+#include "book_manager.h"
+#include "sharded_matching.h"
 #include "testing_framework.h"
 
 int main(int argc, char* argv[]) {
     OrderBook orderBook;
 
+    // Trade tape options may appear anywhere; strip them before choosing the mode
+    std::string tapePath;
+    TapeFormat tapeFormat = TapeFormat::BINARY;
+    TapeDurability tapeDurability = TapeDurability::BUFFERED;
+    std::vector<char*> args{argv[0]};
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if ((option == "--tape" || option == "--tape-format" || option == "--tape-durability") && i + 1 < argc) {
+            std::string value = argv[++i];
+            bool valid = true;
+            if (option == "--tape") {
+                tapePath = value;
+            } else if (option == "--tape-format") {
+                valid = parseTapeFormat(value, tapeFormat);
+            } else {
+                valid = parseTapeDurability(value, tapeDurability);
+            }
+            if (!valid) {
+                std::cerr << "Error: invalid value '" << value << "' for " << option << std::endl;
+                return 1;
+            }
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    argc = static_cast<int>(args.size());
+    argv = args.data();
+
+    // Replay many files in parallel; --tape names a directory receiving one tape per file
+    if (argc >= 3 && std::string(argv[1]) == "--batch") {
+        unsigned workers = 0;
+        std::vector<std::string> inputs;
+        for (int i = 2; i < argc; ++i) {
+            if (std::string(argv[i]) == "--workers" && i + 1 < argc) {
+                std::string value = argv[++i];
+                if (!parseCsvNumber(value, workers)) {
+                    std::cerr << "Error: invalid value '" << value << "' for --workers" << std::endl;
+                    return 1;
+                }
+            } else {
+                inputs.push_back(argv[i]);
+            }
+        }
+        return processBatch(inputs, workers, tapePath, tapeFormat, tapeDurability) ? 0 : 1;
+    }
+
+    std::unique_ptr<TradeTape> tape;
+    if (!tapePath.empty()) {
+        tape = std::make_unique<TradeTape>(tapePath, tapeFormat, tapeDurability);
+        if (!tape->isOpen()) {
+            std::cerr << "Error: Cannot create trade tape " << tapePath << std::endl;
+            return 1;
+        }
+    }
+
+    // Verify the SIMD tokenizer kernels against the reference field splitter
+    if (argc == 3 && std::string(argv[1]) == "--check-tokenizer") {
+        return checkCsvTokenizer(argv[2]) ? 0 : 1;
+    }
+
+    // Verify all-or-none and minimum-quantity matching against a brute-force reference book
+    if (argc == 3 && std::string(argv[1]) == "--check-constraints") {
+        std::uint64_t count = 0;
+        if (!parseCsvNumber(std::string_view(argv[2]), count)) {
+            std::cerr << "Usage: ./orderbook --check-constraints <order_count>" << std::endl;
+            return 1;
+        }
+        return checkFillConstraints(count) ? 0 : 1;
+    }
+
+    // Convert a CSV order file to the binary event format
+    if (argc == 4 && std::string(argv[1]) == "--convert") {
+        return convertCsvToBinary(argv[2], argv[3]) ? 0 : 1;
+    }
+
+    // Stream commands from stdin, or from a FIFO when a path is given
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--stream") {
+        bool ok = argc == 3 ? processOrderStreamPath(argv[2], orderBook, tape.get())
+                            : processOrderStream(0, 1, orderBook, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+
+    // FIX order entry: replay a message file, benchmark the parser, or generate flow for it
+    if (argc == 3 && std::string(argv[1]) == "--fix") {
+        bool ok = processFixFile(argv[2], orderBook, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+    if (argc == 3 && std::string(argv[1]) == "--fix-bench") {
+        return benchmarkFixFile(argv[2]) ? 0 : 1;
+    }
+    if (argc == 4 && std::string(argv[1]) == "--fix-generate") {
+        std::uint64_t count = 0;
+        if (!parseCsvNumber(std::string_view(argv[3]), count)) {
+            std::cerr << "Usage: ./orderbook --fix-generate <file> <message_count>" << std::endl;
+            return 1;
+        }
+        return generateFixFile(argv[2], count) ? 0 : 1;
+    }
+
+    // Loopback TCP order entry, and a load generator with simulated clients
+    if (argc == 3 && std::string(argv[1]) == "--gateway") {
+        std::uint16_t port = 0;
+        if (!parseCsvNumber(std::string_view(argv[2]), port)) {
+            std::cerr << "Usage: ./orderbook --gateway <port>" << std::endl;
+            return 1;
+        }
+        bool ok = runOrderGateway(port, orderBook, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+    if (argc == 5 && std::string(argv[1]) == "--gateway-load") {
+        std::uint16_t port = 0;
+        unsigned clients = 0;
+        std::uint64_t orders = 0;
+        if (!parseCsvNumber(std::string_view(argv[2]), port) || !parseCsvNumber(std::string_view(argv[3]), clients) ||
+            !parseCsvNumber(std::string_view(argv[4]), orders) || port == 0 || clients == 0) {
+            std::cerr << "Usage: ./orderbook --gateway-load <port> <clients> <orders_per_client>" << std::endl;
+            return 1;
+        }
+        return runGatewayLoad(port, clients, orders) ? 0 : 1;
+    }
+
+    // Shared-memory order entry for clients on the same host
+    if (argc == 3 && std::string(argv[1]) == "--shm-engine") {
+        bool ok = runShmEngine(argv[2], orderBook, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+    if (argc == 4 && std::string(argv[1]) == "--shm-client") {
+        std::uint64_t orders = 0;
+        if (!parseCsvNumber(std::string_view(argv[3]), orders)) {
+            std::cerr << "Usage: ./orderbook --shm-client <segment> <orders>" << std::endl;
+            return 1;
+        }
+        return runShmClientBenchmark(argv[2], orders) ? 0 : 1;
+    }
+
+    // CSV replay with reads queued ahead through io_uring instead of a memory mapping
+    if (argc == 3 && std::string(argv[1]) == "--uring") {
+        bool ok = processCsvFileAsync(argv[2], orderBook, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+
+    // One book per symbol, routed by the optional leading symbol column
+    if ((argc == 3 || argc == 4) && std::string(argv[1]) == "--symbols") {
+        bool globalIds = argc == 4 && std::string(argv[2]) == "--global-ids";
+        if (argc == 4 && !globalIds) {
+            std::cerr << "Usage: ./orderbook --symbols [--global-ids] <csv_file>" << std::endl;
+            return 1;
+        }
+        BookManager books(globalIds ? OrderIdScope::GLOBAL : OrderIdScope::PER_SYMBOL);
+        processMultiSymbolCsvFile(argv[argc - 1], books, tape.get());
+        if (tape && !tape->close()) {
+            return 1;
+        }
+        return 0;
+    }
+
+    // Multi-symbol replay with symbols partitioned across pinned matching threads
+    if (argc >= 3 && std::string(argv[1]) == "--sharded") {
+        unsigned workers = 0;
+        std::string outputPath;
+        bool rebalance = true;
+        int index = 2;
+        bool valid = true;
+        while (valid && index < argc - 1) {
+            std::string option = argv[index];
+            if (option == "--static") {
+                rebalance = false;
+                index += 1;
+                continue;
+            }
+            if (option == "--workers" && index + 1 < argc - 1) {
+                valid = parseCsvNumber(std::string_view(argv[index + 1]), workers);
+            } else if (option == "--output" && index + 1 < argc - 1) {
+                outputPath = argv[index + 1];
+            } else {
+                valid = false;
+            }
+            index += 2;
+        }
+        if (!valid || index != argc - 1) {
+            std::cerr << "Usage: ./orderbook --sharded [--workers N] [--output results.csv] [--static] <csv_file>"
+                      << std::endl;
+            return 1;
+        }
+        bool ok = processShardedFile(argv[argc - 1], workers, outputPath, rebalance, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+
+    // Rebuild a book from an ITCH-style order feed capture
+    if ((argc == 3 || argc == 5) && std::string(argv[1]) == "--itch") {
+        std::optional<std::uint16_t> locate;
+        if (argc == 5) {
+            std::uint16_t value = 0;
+            if (std::string(argv[2]) != "--locate" || !parseCsvNumber(std::string_view(argv[3]), value)) {
+                std::cerr << "Usage: ./orderbook --itch [--locate <stock_locate>] <capture>" << std::endl;
+                return 1;
+            }
+            locate = value;
+        }
+        bool ok = processItchFile(argv[argc - 1], orderBook, locate, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+
+    // Release events at recorded pace (optionally scaled) and measure latency against the schedule
+    if ((argc == 3 || argc == 5) && std::string(argv[1]) == "--paced") {
+        double speed = 1.0;
+        if (argc == 5) {
+            if (std::string(argv[2]) != "--speed" || !parseCsvNumber(std::string_view(argv[3]), speed) || speed <= 0) {
+                std::cerr << "Usage: ./orderbook --paced [--speed <multiplier>] <file>" << std::endl;
+                return 1;
+            }
+        }
+        bool ok = processPacedFile(argv[argc - 1], orderBook, speed, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+
+    // Replay CSV or binary events with parsing and matching on separate threads
+    if (argc == 3 && std::string(argv[1]) == "--pipelined") {
+        std::cout << "Welcome to the Order Book Testing Framework!\n";
+        std::cout << "Running in pipelined replay mode with file: " << argv[2] << "\n\n";
+
+        processPipelinedFile(argv[2], orderBook, tape.get());
+        if (tape && !tape->close()) {
+            return 1;
+        }
+        return 0;
+    }
+
+    // Replay CSV while reader threads snapshot the published top of book
+    if (argc == 4 && std::string(argv[1]) == "--tob-readers") {
+        unsigned readers = 0;
+        if (!parseCsvNumber(std::string_view(argv[2]), readers)) {
+            std::cerr << "Usage: ./orderbook --tob-readers <threads> <csv_file>" << std::endl;
+            return 1;
+        }
+        bool ok = runTopOfBookReaders(argv[3], orderBook, readers, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+
+    // Replay CSV while reader threads copy the published depth
+    if (argc == 4 && std::string(argv[1]) == "--depth-readers") {
+        unsigned readers = 0;
+        if (!parseCsvNumber(std::string_view(argv[2]), readers)) {
+            std::cerr << "Usage: ./orderbook --depth-readers <threads> <csv_file>" << std::endl;
+            return 1;
+        }
+        bool ok = runDepthReaders(argv[3], orderBook, readers, tape.get());
+        ok = (!tape || tape->close()) && ok;
+        return ok ? 0 : 1;
+    }
+
+    // Replay a binary event file
+    if (argc == 3 && std::string(argv[1]) == "--binary") {
+        std::cout << "Welcome to the Order Book Testing Framework!\n";
+        std::cout << "Running in binary replay mode with file: " << argv[2] << "\n\n";
+
+        processBinaryFile(argv[2], orderBook, tape.get());
+        if (tape && !tape->close()) {
+            return 1;
+        }
+        return 0;
+    }
+
     // Check if CSV file is provided as command line argument
     if (argc == 2) {
         std::cout << "Welcome to the Order Book Testing Framework!\n";
         std::cout << "Running in CSV mode with file: " << argv[1] << "\n\n";
 
-        processCsvFile(argv[1], orderBook);
+        processCsvFile(argv[1], orderBook, tape.get());
+        if (tape && !tape->close()) {
+            return 1;
+        }
         return 0;
     }
 
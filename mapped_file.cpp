@@ -0,0 +1,49 @@
+/**
+ * Memory-Mapped File Implementation
+ * POSIX mmap wrapper used by the bulk ingestion paths
+ */
+
+#include "mapped_file.h"
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, madvise, munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return;
+    }
+
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ == 0) {
+        // mmap rejects zero-length mappings - an empty file is simply an empty view
+        ::close(fd);
+        open_ = true;
+        return;
+    }
+
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps its own reference to the file
+
+    if (mapping == MAP_FAILED) {
+        size_ = 0;
+        return;
+    }
+
+    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(mapping);
+    open_ = true;
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
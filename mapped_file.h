@@ -0,0 +1,48 @@
+/**
+ * Memory-Mapped File Module
+ * Read-only view of a whole input file without copying it through stream buffers
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * RAII read-only mapping of a regular file
+ * The mapping is private and advised for sequential access, so the kernel reads ahead
+ * and drops pages behind the cursor; files larger than memory are fine
+ */
+class MappedFile
+{
+    public:
+    /**
+     * Map a file into memory
+     * @param path Path to a regular file (pipes and other unseekable files cannot be mapped)
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Check whether the file was opened and mapped
+     * @return true if data() is valid (an empty file is open with an empty view)
+     */
+    bool isOpen() const { return open_; }
+
+    /**
+     * Access the mapped contents
+     * @return View over the whole file
+     */
+    std::string_view data() const { return std::string_view(data_, size_); }
+
+    std::size_t size() const { return size_; }
+
+    private:
+    const char* data_ = nullptr; // Start of the mapping (null for empty files)
+    std::size_t size_ = 0;       // Mapped length in bytes
+    bool open_ = false;          // Whether the file was opened successfully
+};
@@ -0,0 +1,266 @@
+/**
+ * Market Data Readers Implementation
+ * Matching on the calling thread, snapshot readers on their own threads
+ */
+
+#include "market_data.h"
+#include "console_mute.h"   // Engine log suppression during the replay
+#include "csv_processor.h"  // CsvCommandReader
+#include "mapped_file.h"    // Zero-copy input
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::uint64_t DEPTH_CHECK_INTERVAL = 1024; // Commands between depth checks on the matching thread
+
+/**
+ * What one reader thread saw
+ */
+struct ReaderStats
+{
+    std::uint64_t snapshots_ = 0;  // Consistent snapshots taken
+    std::uint64_t retries_ = 0;    // Attempts that overlapped a publish
+    std::uint64_t changes_ = 0;    // Snapshots with a newer sequence than the previous one
+    std::uint64_t errors_ = 0;     // Inconsistent snapshots
+};
+
+/**
+ * Totals of the replay on the matching thread
+ */
+struct ReplayStats
+{
+    std::uint64_t commands_ = 0;
+    std::uint64_t rejected_ = 0;
+    std::uint64_t trades_ = 0;
+    double seconds_ = 0.0;
+};
+
+bool sideConsistent(std::int32_t price, std::uint64_t quantity) {
+    return (price == 0) == (quantity == 0);
+}
+
+void readTopOfBook(const OrderBook& orderBook, const std::atomic<bool>& done, ReaderStats& stats) {
+    std::uint64_t lastSequence = 0;
+    TopOfBook top;
+    while (!done.load(std::memory_order_acquire)) {
+        if (!orderBook.tryGetTopOfBook(top)) {
+            stats.retries_++;
+            cpuRelax();
+            continue;
+        }
+        stats.snapshots_++;
+        if (top.sequence_ < lastSequence || !sideConsistent(top.bidPrice_, top.bidQuantity_) ||
+            !sideConsistent(top.askPrice_, top.askQuantity_)) {
+            stats.errors_++;
+        }
+        if (top.sequence_ != lastSequence) {
+            stats.changes_++;
+            lastSequence = top.sequence_;
+        }
+    }
+}
+
+/**
+ * Check that levels are strictly ordered best-first and none is empty
+ */
+bool depthOrdered(const std::vector<DepthLevel>& levels, bool bid) {
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        if (levels[i].quantity_ == 0) {
+            return false;
+        }
+        if (i > 0 && (bid ? levels[i].price_ >= levels[i - 1].price_ : levels[i].price_ <= levels[i - 1].price_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void readDepth(const OrderBook& orderBook, const std::atomic<bool>& done, ReaderStats& stats) {
+    std::uint64_t lastSequence = 0;
+    DepthSnapshot depth;
+    while (!done.load(std::memory_order_acquire)) {
+        orderBook.getDepthSnapshot(depth);
+        stats.snapshots_++;
+        if (depth.sequence_ < lastSequence || !depthOrdered(depth.bids_, true) || !depthOrdered(depth.asks_, false)) {
+            stats.errors_++;
+        }
+        if (depth.sequence_ != lastSequence) {
+            stats.changes_++;
+            lastSequence = depth.sequence_;
+        }
+    }
+}
+
+/**
+ * Compare published depth with the book's own aggregation (matching thread only)
+ */
+bool depthMatchesBook(const DepthSnapshot& depth, const OrderBook& orderBook) {
+    OrderBookBAA levels = orderBook.getOrderBookLevelInfos();
+    auto same = [](const std::vector<DepthLevel>& published, const OrderBookLevels& expected) {
+        if (published.size() != expected.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < published.size(); ++i) {
+            if (published[i].price_ != expected[i].price_.get() ||
+                published[i].quantity_ != expected[i].quantity_.get()) {
+                return false;
+            }
+        }
+        return true;
+    };
+    return same(depth.bids_, levels.getBids()) && same(depth.asks_, levels.getAsks());
+}
+
+/**
+ * Replay a CSV file on the calling thread while reader threads run
+ * @param afterCommand Called on the matching thread after each command with the command count
+ * @return false if the file could not be opened
+ */
+template<typename Reader, typename AfterCommand>
+bool replayWithReaders(const std::string& filename, OrderBook& orderBook, unsigned readers, TradeTape* tape,
+                       Reader readFn, AfterCommand afterCommand, std::vector<ReaderStats>& stats, ReplayStats& replay) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return false;
+    }
+
+    std::atomic<bool> done{false};
+    stats.assign(readers, ReaderStats{});
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < readers; ++i) {
+        threads.emplace_back(readFn, std::cref(orderBook), std::cref(done), std::ref(stats[i]));
+    }
+
+    CsvCommandReader reader(file.data());
+    OrderCommand command;
+    auto mute = std::make_unique<ConsoleMute>(); // Released before the summary
+    auto start = std::chrono::steady_clock::now();
+    while (reader.next(command)) {
+        replay.commands_++;
+        try {
+            Trades trades = applyOrderCommand(orderBook, command);
+            replay.trades_ += trades.size();
+            if (tape) {
+                tape->record(trades);
+                tape->commit();
+            }
+        } catch (const std::exception&) {
+            replay.rejected_++;
+        }
+        afterCommand(replay.commands_);
+    }
+    replay.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done.store(true, std::memory_order_release);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return true;
+}
+
+/**
+ * Print per-reader lines and the replay totals
+ * @return Inconsistent snapshots across all readers
+ */
+std::uint64_t printReplaySummary(const std::string& title, const std::vector<ReaderStats>& stats,
+                                 const ReplayStats& replay, bool showRetries) {
+    std::uint64_t errors = 0;
+    std::cout << title << " with " << stats.size() << " reader(s)\n";
+    std::cout << "=================================================\n";
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const ReaderStats& reader = stats[i];
+        errors += reader.errors_;
+        std::cout << "Reader " << i << ": " << reader.snapshots_ << " snapshot(s), " << reader.changes_
+                  << " change(s) seen, ";
+        if (showRetries) {
+            std::cout << reader.retries_ << " retr" << (reader.retries_ == 1 ? "y" : "ies") << ", ";
+        }
+        std::cout << reader.errors_ << " inconsistent\n";
+    }
+    std::cout << "=================================================\n";
+    std::cout << "Commands: " << replay.commands_ << " (" << replay.rejected_ << " rejected), trades: "
+              << replay.trades_ << "\n";
+    return errors;
+}
+
+void printReplayRate(const ReplayStats& replay) {
+    std::cout << "Replay: " << std::fixed << std::setprecision(3) << replay.seconds_ * 1000.0 << " ms, "
+              << std::setprecision(0)
+              << (replay.seconds_ > 0 ? static_cast<double>(replay.commands_) / replay.seconds_ : 0.0)
+              << " commands/s\n";
+}
+
+} // namespace
+
+bool runTopOfBookReaders(const std::string& filename, OrderBook& orderBook, unsigned readers, TradeTape* tape) {
+    std::vector<ReaderStats> stats;
+    ReplayStats replay;
+    orderBook.enableTopOfBook();
+    if (!replayWithReaders(filename, orderBook, readers, tape, readTopOfBook, [](std::uint64_t) {}, stats, replay)) {
+        return false;
+    }
+
+    TopOfBook top = orderBook.getTopOfBook();
+    std::uint64_t errors = printReplaySummary("Top of book replay of " + filename, stats, replay, true);
+    std::cout << "Publishes: " << top.sequence_ << "\n";
+    std::cout << "Final top of book: ";
+    if (top.bidQuantity_) {
+        std::cout << top.bidQuantity_ << " @ " << top.bidPrice_;
+    } else {
+        std::cout << "-";
+    }
+    std::cout << " / ";
+    if (top.askQuantity_) {
+        std::cout << top.askQuantity_ << " @ " << top.askPrice_;
+    } else {
+        std::cout << "-";
+    }
+    std::cout << ", last trade " << top.lastTradeQuantity_ << " @ " << top.lastTradePrice_ << "\n";
+    printReplayRate(replay);
+    return errors == 0;
+}
+
+bool runDepthReaders(const std::string& filename, OrderBook& orderBook, unsigned readers, TradeTape* tape) {
+    std::vector<ReaderStats> stats;
+    ReplayStats replay;
+    DepthSnapshot depth;
+    std::uint64_t checks = 0;
+    std::uint64_t deferred = 0;
+    std::uint64_t mismatches = 0;
+
+    // Periodically confirm the incrementally maintained depth against a full aggregation
+    auto check = [&](std::uint64_t commands) {
+        if (commands % DEPTH_CHECK_INTERVAL != 0) {
+            return;
+        }
+        if (!orderBook.flushDepth()) {
+            deferred++;
+            return;
+        }
+        orderBook.getDepthSnapshot(depth);
+        checks++;
+        if (!depthMatchesBook(depth, orderBook)) {
+            mismatches++;
+        }
+    };
+    orderBook.enableDepth();
+    if (!replayWithReaders(filename, orderBook, readers, tape, readDepth, check, stats, replay)) {
+        return false;
+    }
+
+    bool current = orderBook.flushDepth();
+    orderBook.getDepthSnapshot(depth);
+    bool finalMatches = current && depthMatchesBook(depth, orderBook);
+    std::uint64_t errors = printReplaySummary("Depth replay of " + filename, stats, replay, false);
+    std::cout << "Depth checks against the book: " << checks << " (" << mismatches << " mismatched, " << deferred
+              << " skipped while readers held every back buffer)\n";
+    std::cout << "Final depth: " << depth.bids_.size() << " bid level(s), " << depth.asks_.size()
+              << " ask level(s), sequence " << depth.sequence_ << (finalMatches ? "" : " (DOES NOT MATCH BOOK)") << "\n";
+    printReplayRate(replay);
+    return errors == 0 && mismatches == 0 && finalMatches;
+}
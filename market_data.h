@@ -0,0 +1,39 @@
+/**
+ * Market Data Readers Module
+ * Replays a file on the calling thread while other threads read the book's published state
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "trade_tape.h"
+#include <string>
+
+/**
+ * Replay a CSV file while reader threads continuously snapshot the book's top of book
+ * Each reader checks every snapshot for consistency (sequence never goes backwards, an empty
+ * side has no price) and counts snapshot attempts that overlapped a publish. The engine log
+ * is muted; replay throughput is reported so it can be compared across reader counts.
+ * @param filename Path to CSV file
+ * @param orderBook Order book instance to process orders against
+ * @param readers Number of reader threads
+ * @param tape Optional tape receiving every trade (committed after each command)
+ * @return false if the file could not be opened or a reader saw an inconsistent snapshot
+ */
+bool runTopOfBookReaders(const std::string& filename, OrderBook& orderBook, unsigned readers,
+                         TradeTape* tape = nullptr);
+
+/**
+ * Replay a CSV file while reader threads continuously copy the book's published depth
+ * Each reader checks every snapshot for consistency (sequence never goes backwards, levels
+ * strictly ordered best-first, no empty level). Every 1024 commands the matching thread also
+ * compares the published depth with getOrderBookLevelInfos(), which rebuilds it from the book.
+ * @param filename Path to CSV file
+ * @param orderBook Order book instance to process orders against
+ * @param readers Number of reader threads
+ * @param tape Optional tape receiving every trade (committed after each command)
+ * @return false if the file could not be opened, a reader saw an inconsistent snapshot or the
+ *         published depth differed from the book
+ */
+bool runDepthReaders(const std::string& filename, OrderBook& orderBook, unsigned readers,
+                     TradeTape* tape = nullptr);
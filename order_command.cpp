@@ -0,0 +1,21 @@
+/**
+ * Order Command Implementation
+ * Maps decoded commands onto OrderBook calls
+ */
+
+#include "order_command.h"
+
+Trades applyOrderCommand(OrderBook& orderBook, const OrderCommand& command) {
+    switch (command.action_) {
+        case OrderAction::CREATE:
+            return orderBook.addOrder(std::make_shared<Order>(command.orderId_, command.side_, command.type_,
+                                                              Price(command.price_), Quantity(command.quantity_)));
+        case OrderAction::MODIFY:
+            return orderBook.matchOrder(OrderModifier(command.orderId_, command.side_, command.type_,
+                                                      Price(command.price_), Quantity(command.quantity_)));
+        case OrderAction::CANCEL:
+            orderBook.cancelOrder(command.orderId_);
+            break;
+    }
+    return {};
+}
@@ -0,0 +1,43 @@
+/**
+ * Order Command Module
+ * Compact, allocation-free representation of one order operation decoded from an input source
+ */
+
+#pragma once
+
+#include "orderbook.h"
+
+/**
+ * Operation requested by an input record
+ */
+enum class OrderAction : std::uint8_t
+{
+    CREATE, // add a new order
+    MODIFY, // cancel/replace an existing order
+    CANCEL  // remove an existing order (only the order id is meaningful)
+};
+
+/**
+ * One decoded order operation
+ * Holds raw numeric fields so decoders can fill it without constructing strong types;
+ * validation happens when the command is applied to a book
+ */
+struct OrderCommand
+{
+    OrderAction action_ = {};     // Requested operation
+    OrderSide side_ = {};         // Order side (CREATE/MODIFY; zero for CANCEL)
+    OrderType type_ = {};         // Order type (CREATE/MODIFY; zero for CANCEL)
+    OrderId orderId_ = {};        // Target order
+    std::int32_t price_ = {};     // Limit price (CREATE/MODIFY; zero for CANCEL)
+    std::uint32_t quantity_ = {}; // Order quantity (CREATE/MODIFY; zero for CANCEL)
+    std::uint64_t timestamp_ = {}; // Event time in nanoseconds (0 when the source has no time)
+};
+
+/**
+ * Apply a decoded command to an order book
+ * @param orderBook Order book to apply the command to
+ * @param command Decoded operation
+ * @return Trades generated by the operation (always empty for CANCEL)
+ * @throws std::invalid_argument if price or quantity is not positive
+ */
+Trades applyOrderCommand(OrderBook& orderBook, const OrderCommand& command);
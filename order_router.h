@@ -0,0 +1,116 @@
+/**
+ * Order Router Module
+ * Order ownership and ACK/REJECT/FILL routing shared by the order entry transports
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "order_command.h"
+#include "tcp_gateway.h"  // GatewayResponse
+#include "trade_tape.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Applies client requests to a book on behalf of client sessions
+ * Every resting order is owned by the session that created it. A CREATE must claim an id
+ * that no resting order holds, and a CANCEL or MODIFY is only applied for the order's owner;
+ * anything else is rejected without touching the book. Fills go to the owner of each side.
+ * The book reports every id it removes, so ownership ends exactly when the order leaves it,
+ * however that happens.
+ * @tparam Session Transport's handle on a client session (copyable, equality comparable)
+ */
+template<typename Session>
+class OrderRouter
+{
+    public:
+    /**
+     * Route requests into a book
+     * @param orderBook Book to apply requests to (reports its removed ids to the router until
+     *                  the router is destroyed)
+     * @param tape Optional tape receiving every trade (the transport commits it)
+     */
+    OrderRouter(OrderBook& orderBook, TradeTape* tape) : orderBook_(orderBook), tape_(tape) {
+        orderBook_.trackRemovedOrders(&removed_);
+    }
+
+    ~OrderRouter() { orderBook_.trackRemovedOrders(nullptr); }
+
+    OrderRouter(const OrderRouter&) = delete;
+    OrderRouter& operator=(const OrderRouter&) = delete;
+
+    /**
+     * Validate and apply one request, sending a FILL to the owner of each side of every trade
+     * @param sender Session the request came from
+     * @param command Request
+     * @param sendFill Called as sendFill(owner, fill) for each fill; the owner may have gone away
+     * @return ACK (status 1 if the order rests) or REJECT for the sender, echoing the request timestamp
+     */
+    template<typename SendFill>
+    GatewayResponse apply(const Session& sender, const OrderCommand& command, SendFill sendFill) {
+        GatewayResponse ack{GatewayResponseType::ACK, command.action_, 0, 0, command.orderId_, command.timestamp_, 0};
+
+        bool permitted;
+        if (command.action_ == OrderAction::CREATE) {
+            permitted = owners_.try_emplace(command.orderId_, sender).second;
+        } else {
+            auto owner = owners_.find(command.orderId_);
+            permitted = owner != owners_.end() && owner->second == sender;
+        }
+        if (!permitted) {
+            rejected_++;
+            ack.type_ = GatewayResponseType::REJECT;
+            return ack;
+        }
+
+        removed_.clear();
+        try {
+            Trades trades = applyOrderCommand(orderBook_, command);
+            trades_ += trades.size();
+            if (tape_) {
+                tape_->record(trades);
+            }
+            for (const Trade& trade : trades) {
+                routeFill(trade.getBid().orderId_, OrderSide::BUY, trade.getAsk().orderId_, trade, sendFill);
+                routeFill(trade.getAsk().orderId_, OrderSide::SELL, trade.getBid().orderId_, trade, sendFill);
+            }
+            ack.status_ = orderBook_.orderExists(command.orderId_) ? 1 : 0;
+        } catch (const std::exception&) {
+            rejected_++;
+            ack.type_ = GatewayResponseType::REJECT;
+        }
+
+        // The request's own id is checked too: a rejected CREATE never entered the book
+        removed_.push_back(command.orderId_);
+        for (OrderId orderId : removed_) {
+            if (!orderBook_.orderExists(orderId)) {
+                owners_.erase(orderId);
+            }
+        }
+        removed_.clear();
+        return ack;
+    }
+
+    std::uint64_t getRejected() const { return rejected_; }
+    std::uint64_t getTrades() const { return trades_; }
+
+    private:
+    template<typename SendFill>
+    void routeFill(OrderId orderId, OrderSide side, OrderId counterparty, const Trade& trade, SendFill& sendFill) {
+        auto owner = owners_.find(orderId);
+        if (owner != owners_.end()) {
+            sendFill(owner->second, GatewayResponse{GatewayResponseType::FILL, OrderAction::CREATE,
+                                                    static_cast<std::uint8_t>(side), trade.getBid().quantity_.get(),
+                                                    orderId, counterparty, trade.getPrice().get()});
+        }
+    }
+
+    OrderBook& orderBook_;
+    TradeTape* tape_;
+    std::unordered_map<OrderId, Session> owners_; // Resting order -> session that created it
+    std::vector<OrderId> removed_;                // Ids the current request took out of the book
+    std::uint64_t rejected_ = 0;                  // Requests refused
+    std::uint64_t trades_ = 0;                    // Trades executed
+};
@@ -4,6 +4,9 @@
  */
 
 #include "orderbook.h"
+#include <bit>          // Match index capacity
+#include <cstdlib>      // std::abs for auction reference distance
+#include <limits>       // Initial trailing stop water mark
 
 // Order class implementation
 void Order::fill(Quantity quantity)
@@ -15,147 +18,659 @@ void Order::fill(Quantity quantity)
     remainingQuantity_ -= quantity;
 }
 
+void Order::decrement(Quantity quantity)
+{
+    if (quantity > remainingQuantity_)
+    {
+        throw std::invalid_argument("Quantity to decrement is greater than remaining quantity");
+    }
+    decrementedQuantity_ += quantity.get();
+    remainingQuantity_ -= quantity;
+}
+
+void Order::fireOco(std::vector<Order*>& siblings)
+{
+    for (Order* sibling = ocoNext_; sibling != nullptr && sibling != this; ) {
+        Order* next = sibling->ocoNext_;
+        siblings.push_back(sibling);
+        sibling->ocoCancelled_ = true;
+        sibling->ocoPrev_ = sibling->ocoNext_ = nullptr;
+        sibling = next;
+    }
+    ocoPrev_ = ocoNext_ = nullptr;
+}
+
+void Order::unlinkOco()
+{
+    if (ocoNext_ == nullptr) {
+        return;
+    }
+    if (ocoNext_ == ocoPrev_) {
+        // Last sibling left on its own - the group no longer exists
+        ocoNext_->ocoPrev_ = ocoNext_->ocoNext_ = nullptr;
+    } else {
+        ocoPrev_->ocoNext_ = ocoNext_;
+        ocoNext_->ocoPrev_ = ocoPrev_;
+    }
+    ocoPrev_ = ocoNext_ = nullptr;
+}
+
+void Order::replaceInOco(Order& replaced)
+{
+    if (replaced.ocoNext_ == nullptr) {
+        return;
+    }
+    ocoMode_ = replaced.ocoMode_;
+    ocoPrev_ = replaced.ocoPrev_;
+    ocoNext_ = replaced.ocoNext_;
+    ocoPrev_->ocoNext_ = this;
+    ocoNext_->ocoPrev_ = this;
+    replaced.ocoPrev_ = replaced.ocoNext_ = nullptr;
+}
+
+void linkOneCancelsOther(const std::vector<OrderPointer>& orders, OcoMode mode)
+{
+    if (orders.size() < 2) {
+        throw std::invalid_argument("An OCO group needs at least two orders");
+    }
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        orders[i]->unlinkOco();
+    }
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        orders[i]->ocoMode_ = mode;
+        orders[i]->ocoNext_ = orders[(i + 1) % orders.size()].get();
+        orders[i]->ocoPrev_ = orders[(i + orders.size() - 1) % orders.size()].get();
+    }
+}
+
 // OrderModifier class implementation
-OrderPointer OrderModifier::toOrderPointer(OrderType type) const
+OrderPointer OrderModifier::toOrderPointer(const Order& existing) const
 {
-    return std::make_shared<Order>(getOrderId(), getOrderSide(), type, getPrice(), getQuantity());
+    auto order = std::make_shared<Order>(getOrderId(), getOrderSide(), existing.getOrderType(), getPrice(), getQuantity(),
+                                         existing.getFillConstraint(), existing.getMinimumQuantity());
+    order->setPeg(existing.getPegType(), existing.getPegOffset());
+    order->setOwner(existing.getOwner());
+    if (existing.isTrailingStop()) {
+        order->setTrailingStop(existing.getTrailingOffset());
+    }
+    return order;
+}
+
+// PriceLevel class implementation
+OrderPointers::iterator PriceLevel::add(const OrderPointer& order)
+{
+    std::uint32_t threshold = order->getExecutionThreshold();
+    auto& queue = (threshold == 0) ? unconstrained_ : constrained_;
+    totalQuantity_ += order->getRemainingQuantity().get();
+    if (threshold == 0) {
+        unconstrainedQuantity_ += order->getRemainingQuantity().get();
+    }
+    auto location = queue.insert(queue.end(), order);
+    order->level_ = this;
+    order->location_ = location;
+
+    if (indexCapacity_ == 0) {
+        if (threshold != 0) {
+            buildIndex();
+        }
+    } else if (nextSlot_ == indexCapacity_) {
+        buildIndex();  // Out of slots - renumber the live orders (includes this one)
+    } else {
+        order->levelSlot_ = nextSlot_;
+        slotOrders_[nextSlot_] = location;
+        setSlot(nextSlot_++, threshold, order->getRemainingQuantity().get());
+    }
+    return location;
+}
+
+void PriceLevel::remove(std::uint32_t threshold, OrderPointers::iterator location)
+{
+    totalQuantity_ -= (*location)->getRemainingQuantity().get();
+    if (indexCapacity_ != 0) {
+        setSlot((*location)->levelSlot_, 0, 0);
+    }
+    (*location)->level_ = nullptr;
+    if (threshold == 0) {
+        unconstrainedQuantity_ -= (*location)->getRemainingQuantity().get();
+        unconstrained_.erase(location);
+    } else {
+        constrained_.erase(location);
+    }
+}
+
+void PriceLevel::reduce(OrderPointers::iterator location, std::uint32_t threshold, std::uint32_t quantity)
+{
+    totalQuantity_ -= quantity;
+    if (threshold == 0) {
+        unconstrainedQuantity_ -= quantity;
+    }
+    if (indexCapacity_ != 0) {
+        const OrderPointer& order = *location;
+        setSlot(order->levelSlot_, order->getExecutionThreshold(), order->getRemainingQuantity().get());
+    }
+}
+
+std::optional<OrderPointers::iterator> PriceLevel::findMatch(std::uint32_t counterRemaining, std::uint32_t counterThreshold)
+{
+    // Every unconstrained order fits an unconstrained counterparty, so the queue front wins
+    if (counterThreshold == 0 && constrained_.empty()) {
+        return frontUnconstrained();
+    }
+    if (indexCapacity_ == 0) {
+        buildIndex();
+    }
+    std::uint32_t slot = findSlot(1, counterRemaining, std::max(counterThreshold, 1u));
+    if (slot == NO_SLOT) {
+        return std::nullopt;
+    }
+    return slotOrders_[slot];
+}
+
+std::optional<OrderPointers::iterator> PriceLevel::frontUnconstrained()
+{
+    if (unconstrained_.empty()) {
+        return std::nullopt;
+    }
+    return unconstrained_.begin();
+}
+
+void PriceLevel::buildIndex()
+{
+    std::size_t live = size();
+    indexCapacity_ = std::max<std::uint32_t>(MIN_INDEX_CAPACITY, std::bit_ceil(static_cast<std::uint32_t>(live * 2)));
+    minThreshold_.assign(2 * static_cast<std::size_t>(indexCapacity_), NO_SLOT);
+    maxRemaining_.assign(2 * static_cast<std::size_t>(indexCapacity_), 0);
+    slotOrders_.assign(indexCapacity_, OrderPointers::iterator{});
+
+    // Slots follow arrival order across both queues
+    auto plain = unconstrained_.begin();
+    auto constrained = constrained_.begin();
+    for (nextSlot_ = 0; nextSlot_ < live; ++nextSlot_) {
+        bool takePlain = constrained == constrained_.end() ||
+            (plain != unconstrained_.end() && (*plain)->getSequence() < (*constrained)->getSequence());
+        auto location = takePlain ? plain++ : constrained++;
+        const OrderPointer& order = *location;
+        order->levelSlot_ = nextSlot_;
+        slotOrders_[nextSlot_] = location;
+        minThreshold_[indexCapacity_ + nextSlot_] = order->getExecutionThreshold();
+        maxRemaining_[indexCapacity_ + nextSlot_] = order->getRemainingQuantity().get();
+    }
+    for (std::uint32_t node = indexCapacity_ - 1; node > 0; --node) {
+        minThreshold_[node] = std::min(minThreshold_[2 * node], minThreshold_[2 * node + 1]);
+        maxRemaining_[node] = std::max(maxRemaining_[2 * node], maxRemaining_[2 * node + 1]);
+    }
+}
+
+void PriceLevel::setSlot(std::uint32_t slot, std::uint32_t threshold, std::uint32_t remaining)
+{
+    // A filled or removed order can never match
+    std::uint32_t node = indexCapacity_ + slot;
+    minThreshold_[node] = (remaining == 0) ? NO_SLOT : threshold;
+    maxRemaining_[node] = remaining;
+    for (node /= 2; node > 0; node /= 2) {
+        minThreshold_[node] = std::min(minThreshold_[2 * node], minThreshold_[2 * node + 1]);
+        maxRemaining_[node] = std::max(maxRemaining_[2 * node], maxRemaining_[2 * node + 1]);
+    }
+}
+
+std::uint32_t PriceLevel::findSlot(std::uint32_t node, std::uint32_t counterRemaining, std::uint32_t counterThreshold) const
+{
+    // Skip subtrees where no order's threshold fits or no order is large enough
+    if (minThreshold_[node] > counterRemaining || maxRemaining_[node] < counterThreshold) {
+        return NO_SLOT;
+    }
+    if (node >= indexCapacity_) {
+        return node - indexCapacity_;
+    }
+    std::uint32_t slot = findSlot(2 * node, counterRemaining, counterThreshold);
+    return (slot != NO_SLOT) ? slot : findSlot(2 * node + 1, counterRemaining, counterThreshold);
+}
+
+// TrailingStops class implementation
+auto TrailingStops::groupAt(std::int64_t mark) -> GroupPointer&
+{
+    GroupPointer& group = groups_[mark];
+    if (!group) {
+        group = std::make_shared<Group>();
+        group->mark_ = mark;
+        group->trigger_ = triggers_.end();
+    }
+    return group;
+}
+
+void TrailingStops::add(const OrderPointer& order, std::optional<Price> lastTradePrice)
+{
+    // Without a trade yet, park below every reachable mark so the first trade ratchets it
+    std::int64_t mark = lastTradePrice ? orient(*lastTradePrice) : std::numeric_limits<std::int64_t>::min() / 2;
+    GroupPointer& group = groupAt(mark);
+    auto position = group->stops_.emplace(order->getTrailingOffset(), order);
+    reindexGroup(*group);
+    live_[order->getOrderId()] = LiveStop{order, group, position};
+}
+
+bool TrailingStops::cancel(OrderId orderId)
+{
+    auto live = live_.find(orderId);
+    if (live == live_.end()) {
+        return false;
+    }
+    // Follow ratchet merges to the group now holding the node
+    GroupPointer group = live->second.group_;
+    while (group->mergedInto_) {
+        group = group->mergedInto_;
+    }
+    group->stops_.erase(live->second.position_);
+    live_.erase(live);
+
+    if (group->stops_.empty()) {
+        triggers_.erase(group->trigger_);
+        groups_.erase(group->mark_);
+    } else {
+        reindexGroup(*group);
+    }
+    return true;
+}
+
+void TrailingStops::reindexGroup(Group& group)
+{
+    if (group.trigger_ != triggers_.end()) {
+        triggers_.erase(group.trigger_);
+    }
+    group.trigger_ = group.stops_.empty()
+        ? triggers_.end()
+        : triggers_.emplace(group.mark_ - group.stops_.begin()->first, group.mark_);
+}
+
+void TrailingStops::onTrade(Price price, std::vector<OrderPointer>& triggered)
+{
+    std::int64_t oriented = orient(price);
+
+    // Ratchet: every group whose mark the price has moved through now trails from this price.
+    // Nodes are spliced (smaller container into larger), so stored positions stay valid.
+    if (!groups_.empty() && groups_.begin()->first < oriented) {
+        GroupPointer target = groupAt(oriented);
+        while (groups_.begin()->first < oriented) {
+            auto absorbed = groups_.begin();
+            Group& group = *absorbed->second;
+            triggers_.erase(group.trigger_);
+            if (target->stops_.size() < group.stops_.size()) {
+                std::swap(target->stops_, group.stops_);
+            }
+            target->stops_.merge(group.stops_);
+            group.mergedInto_ = target;
+            groups_.erase(absorbed);
+        }
+        reindexGroup(*target);
+    }
+
+    // Trigger: only groups whose nearest stop is reached are visited
+    while (!triggers_.empty() && triggers_.begin()->first >= oriented) {
+        std::int64_t mark = triggers_.begin()->second;
+        Group& group = *groups_.at(mark);
+        while (!group.stops_.empty() && mark - group.stops_.begin()->first >= oriented) {
+            OrderPointer order = group.stops_.begin()->second;
+            group.stops_.erase(group.stops_.begin());
+            live_.erase(order->getOrderId());
+            triggered.push_back(order);
+        }
+        reindexGroup(group);
+        if (group.stops_.empty()) {
+            groups_.erase(mark);
+        }
+    }
 }
 
 // OrderBook class implementation
-bool OrderBook::canMatch(OrderSide side, Price price) const
+template<typename AllocationPolicy>
+bool BasicOrderBook<AllocationPolicy>::canMatch(OrderSide side, Price price) const
 {
     std::cout << "[CANMATCH] Checking if order can match - Side: " 
               << (side == OrderSide::BUY ? "BUY" : "SELL") 
               << ", Price: " << price << "\n";
     
-    // Lambda to handle both bid and ask matching logic
-    auto checkMatch = [&](const auto& sideMap, const std::string& sideName, auto comparator) {
-        if (sideMap.empty()) {
+    // Lambda to handle both bid and ask matching logic, including pegged liquidity
+    auto checkMatch = [&](const auto& sideMap, OrderSide restingSide, const std::string& sideName, auto comparator) {
+        std::optional<Price> best = getBestPegPrice(restingSide);
+        if (!sideMap.empty() && (!best || comparator(sideMap.begin()->first, *best))) {
+            best = sideMap.begin()->first;
+        }
+        if (!best) {
             std::cout << "[CANMATCH] No " << sideName << "s available - cannot match " 
                       << (side == OrderSide::BUY ? "BUY" : "SELL") << " order" << "\n";
             return false;
         }
-        bool canMatch = comparator(price, sideMap.begin()->first);
+        bool canMatch = comparator(price, *best);
         std::cout << "[CANMATCH] " << (side == OrderSide::BUY ? "BUY" : "SELL") 
                   << " order @ " << price << " vs best " << sideName << " @ " 
-                  << sideMap.begin()->first << " - " 
+                  << *best << " - " 
                   << (canMatch ? "CAN MATCH" : "CANNOT MATCH") << "\n";
         return canMatch;
     };
     
     return (side == OrderSide::BUY) 
-        ? checkMatch(asks_, "ask", [](Price p1, Price p2) { return p1 >= p2; })
-        : checkMatch(bids_, "bid", [](Price p1, Price p2) { return p1 <= p2; });
+        ? checkMatch(asks_, OrderSide::SELL, "ask", [](Price p1, Price p2) { return p1 >= p2; })
+        : checkMatch(bids_, OrderSide::BUY, "bid", [](Price p1, Price p2) { return p1 <= p2; });
 }
 
-Trades OrderBook::matchOrders()
+template<typename AllocationPolicy>
+std::optional<std::int32_t> BasicOrderBook<AllocationPolicy>::getPegReference(OrderSide side, PegType type) const
 {
-    std::cout << "[MATCHORDERS] Starting order matching process..." << "\n";
-    Trades trades;
-    trades.reserve(orders_.size());
+    std::optional<std::int32_t> bestBid = bids_.empty() ? std::nullopt : std::optional<std::int32_t>{bids_.begin()->first.get()};
+    std::optional<std::int32_t> bestAsk = asks_.empty() ? std::nullopt : std::optional<std::int32_t>{asks_.begin()->first.get()};
 
-    while(true){
+    switch (type) {
+        case PegType::PRIMARY:
+            return (side == OrderSide::BUY) ? bestBid : bestAsk;
+        case PegType::MARKET:
+            return (side == OrderSide::BUY) ? bestAsk : bestBid;
+        case PegType::MID:
+            if (!bestBid || !bestAsk) {
+                return std::nullopt;
+            }
+            // Round away from the opposite side so a mid peg never improves past the midpoint
+            return (side == OrderSide::BUY) ? (*bestBid + *bestAsk) / 2 : (*bestBid + *bestAsk + 1) / 2;
+        default:
+            return std::nullopt;
+    }
+}
 
-        if (bids_.empty() || asks_.empty())
-        {
-            std::cout << "[MATCHORDERS] No more matching possible - " 
-                      << (bids_.empty() ? "no bids" : "no asks") << "\n";
-            break;
+template<typename AllocationPolicy>
+auto BasicOrderBook<AllocationPolicy>::getPegPricing(OrderSide side) const -> PegPricing
+{
+    PegPricing pricing{side, {}, std::nullopt};
+    for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+        pricing.references_[i] = getPegReference(side, static_cast<PegType>(i + 1));
+    }
+    if (side == OrderSide::BUY) {
+        if (!asks_.empty()) {
+            pricing.limit_ = asks_.begin()->first.get() - 1;
         }
+    } else {
+        // Bids are priced first, so a sell peg also stays clear of the best pegged bid
+        std::optional<Price> bestBid = getBestPegPrice(OrderSide::BUY);
+        if (!bids_.empty() && (!bestBid || bids_.begin()->first > *bestBid)) {
+            bestBid = bids_.begin()->first;
+        }
+        if (bestBid) {
+            pricing.limit_ = bestBid->get() + 1;
+        }
+    }
+    return pricing;
+}
 
-        auto& [bidPrice, bids] = *bids_.begin();
-        auto& [askPrice, asks] = *asks_.begin();
+template<typename AllocationPolicy>
+std::optional<Price> BasicOrderBook<AllocationPolicy>::getBestPegPrice(OrderSide side) const
+{
+    PegPricing pricing = getPegPricing(side);
 
-        // Check if prices can actually match
-        if (bidPrice < askPrice) {
-            std::cout << "[MATCHORDERS] No price overlap - Best bid: " << bidPrice 
-                      << " < Best ask: " << askPrice << " - stopping matching" << "\n";
-            break;
+    // Lambda to find the best priced peg bucket across all references of one side
+    auto bestOf = [&](const auto& pegQueues, auto better) {
+        std::optional<Price> best;
+        for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+            // Buckets are ordered best offset first, so the first priced one is this reference's best
+            for (const auto& [offset, level] : pegQueues[i]) {
+                if (auto price = pricing.price(i, offset)) {
+                    if (!best || better(*price, *best)) {
+                        best = price;
+                    }
+                    break;
+                }
+            }
         }
+        return best;
+    };
+
+    return (side == OrderSide::BUY)
+        ? bestOf(bidPegs_, [](Price p1, Price p2) { return p1 > p2; })
+        : bestOf(askPegs_, [](Price p1, Price p2) { return p1 < p2; });
+}
 
-        std::cout << "[MATCHORDERS] Matching level - Best bid: " << bidPrice 
-                  << " (qty: " << bids.size() << " orders), Best ask: " << askPrice 
-                  << " (qty: " << asks.size() << " orders)" << "\n";
+template<typename AllocationPolicy>
+Trades BasicOrderBook<AllocationPolicy>::matchOrders(const OrderPointer& order, bool& incomingCancelled)
+{
+    std::cout << "[MATCHORDERS] Starting order matching process for Order " << order->getOrderId() << "..." << "\n";
+    Trades trades;
+    incomingCancelled = false;
+    std::vector<Order*> ocoCancels;     // Siblings of OCO members that fired during the current price step
 
-        while (bids.size() && asks.size())
-        {
-            auto& bid = bids.front();
-            auto& ask = asks.front();
+    // Resolved once so the inner loop only needs one owner compare; no resting order carries RESERVED_OWNER
+    const OwnerId selfTradeOwner = (selfTradePrevention_ == SelfTradePrevention::NONE || order->getOwner() == NO_OWNER)
+        ? RESERVED_OWNER
+        : order->getOwner();
+
+    // Lambda to walk the opposite side best-first while it still crosses the incoming price.
+    // Limit levels and peg buckets are merged by price; equal prices go to the earliest arrival.
+    auto matchAgainst = [&](auto& sideMap, auto& pegQueues, OrderSide restingSide, const std::string& sideName,
+                            auto crosses, auto better) {
+        constexpr std::size_t LIMIT_SOURCE = PEG_REFERENCE_COUNT;
 
-            Quantity tradeQuantity = std::min(bid->getRemainingQuantity(), ask->getRemainingQuantity());
+        // Pegs are priced against the touch as it stood when the incoming order arrived
+        PegPricing pricing = getPegPricing(restingSide);
+        std::array<typename std::remove_reference_t<decltype(pegQueues[0])>::iterator, PEG_REFERENCE_COUNT> pegIts;
+        for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+            pegIts[i] = pegQueues[i].begin();
+        }
+        auto levelIt = sideMap.begin();
+        std::uint32_t scannedThreshold = order->getExecutionThreshold();
 
-            std::cout << "[MATCHORDERS] Executing trade - Bid Order " << bid->getOrderId() 
-                      << " (remaining: " << bid->getRemainingQuantity() << ") vs Ask Order " 
-                      << ask->getOrderId() << " (remaining: " << ask->getRemainingQuantity() 
-                      << ") - Trade qty: " << tradeQuantity << "\n";
+        while (!order->isFilled() && !incomingCancelled)
+        {
+            // A level or bucket is only passed over while nothing in it fits the incoming order.
+            // Resting constraints only get harder to meet as the incoming remainder shrinks, but a
+            // minimum-quantity threshold shrinks with it, so once it drops the walk starts over.
+            if (order->getExecutionThreshold() < scannedThreshold) {
+                scannedThreshold = order->getExecutionThreshold();
+                levelIt = sideMap.begin();
+                for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+                    pegIts[i] = pegQueues[i].begin();
+                }
+            }
 
-            bid->fill(tradeQuantity);
-            ask->fill(tradeQuantity);
+            PriceLevel* bestLevel = nullptr;
+            Price bestPrice = order->getPrice();
+            std::size_t bestSource = LIMIT_SOURCE;
+            OrderPointers::iterator location;
 
-            trades.push_back(
-                Trade{
-                    TradeInfo{bid->getOrderId(), bid->getPrice(), tradeQuantity},
-                    TradeInfo{ask->getOrderId(), ask->getPrice(), tradeQuantity}
-                } 
-            ); 
+            // Offer one source's current bucket; false if nothing in it can trade with the incoming order
+            auto offer = [&](PriceLevel& level, Price price, std::size_t source) {
+                auto match = level.findMatch(order->getRemainingQuantity().get(), order->getExecutionThreshold());
+                if (!match) {
+                    std::cout << "[MATCHORDERS] No eligible " << sideName << " at price " << price
+                              << " for remaining qty " << order->getRemainingQuantity() << "\n";
+                    return false;
+                }
+                if (!bestLevel || better(price, bestPrice) ||
+                    (price == bestPrice && (**match)->getSequence() < (*location)->getSequence())) {
+                    bestLevel = &level;
+                    bestPrice = price;
+                    bestSource = source;
+                    location = *match;
+                }
+                return true;
+            };
 
-            if(bid->isFilled())
-            {
-                std::cout << "[MATCHORDERS] Bid Order " << bid->getOrderId() << " fully filled, removing from book" << "\n";
-                OrderId bidOrderId = bid->getOrderId(); 
-                bids.pop_front();
-                orders_.erase(bidOrderId); 
+            while (levelIt != sideMap.end() && crosses(order->getPrice(), levelIt->first) &&
+                   !offer(levelIt->second, levelIt->first, LIMIT_SOURCE)) {
+                ++levelIt;
             }
-            if(ask->isFilled())
-            {
-                std::cout << "[MATCHORDERS] Ask Order " << ask->getOrderId() << " fully filled, removing from book" << "\n";
-                OrderId askOrderId = ask->getOrderId(); 
-                asks.pop_front();
-                orders_.erase(askOrderId); 
+            for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+                while (pricing.references_[i] && pegIts[i] != pegQueues[i].end()) {
+                    if (auto pegPrice = pricing.price(i, pegIts[i]->first)) {
+                        if (!crosses(order->getPrice(), *pegPrice) || offer(pegIts[i]->second, *pegPrice, i)) {
+                            break;
+                        }
+                    }
+                    ++pegIts[i];
+                }
             }
 
-            if (bids.empty())
-            {
-                std::cout << "[MATCHORDERS] All bids at price " << bidPrice << " consumed, removing price level" << "\n";
-                bids_.erase(bidPrice);
+            if (!bestLevel) {
+                std::cout << "[MATCHORDERS] No more crossing " << sideName << "s for Order " << order->getOrderId()
+                          << " @ " << order->getPrice() << " - stopping matching" << "\n";
+                break;
             }
-            if (asks.empty())
-            {
-                std::cout << "[MATCHORDERS] All asks at price " << askPrice << " consumed, removing price level" << "\n";
-                asks_.erase(askPrice);
+
+            // Trade quantity against one resting order at bestPrice; false once the incoming order is done
+            auto execute = [&](OrderPointers::iterator restingLocation, std::uint32_t quantity) {
+                OrderPointer resting = *restingLocation;
+                if (resting->isOcoCancelled()) {
+                    return true; // A sibling fired earlier in this step; cancelled right after it
+                }
+                std::uint32_t restingThreshold = resting->getExecutionThreshold();
+                Quantity tradeQuantity(quantity);
+                bool restingCancelled = false;
+
+                if (resting->getOwner() == selfTradeOwner)
+                {
+                    std::cout << "[MATCHORDERS] Self-trade prevented - Order " << order->getOrderId() << " vs " << sideName
+                              << " Order " << resting->getOrderId() << " (owner " << selfTradeOwner << ")" << "\n";
+                    switch (selfTradePrevention_) {
+                        case SelfTradePrevention::CANCEL_NEWEST:
+                            incomingCancelled = true;
+                            break;
+                        case SelfTradePrevention::CANCEL_OLDEST:
+                            restingCancelled = true;
+                            break;
+                        case SelfTradePrevention::CANCEL_BOTH:
+                            incomingCancelled = true;
+                            restingCancelled = true;
+                            break;
+                        default: // DECREMENT
+                            order->decrement(tradeQuantity);
+                            resting->decrement(tradeQuantity);
+                            bestLevel->reduce(restingLocation, restingThreshold, quantity);
+                            restingCancelled = resting->isFilled();
+                            incomingCancelled = order->isFilled();
+                            break;
+                    }
+                }
+                else
+                {
+                    std::cout << "[MATCHORDERS] Executing trade - Order " << order->getOrderId()
+                              << " (remaining: " << order->getRemainingQuantity() << ") vs " << sideName << " Order "
+                              << resting->getOrderId() << (resting->isPegged() ? " [pegged]" : "")
+                              << " @ " << bestPrice << " (remaining: " << resting->getRemainingQuantity()
+                              << ") - Trade qty: " << tradeQuantity << "\n";
+
+                    order->fill(tradeQuantity);
+                    resting->fill(tradeQuantity);
+                    bestLevel->reduce(restingLocation, restingThreshold, quantity);
+
+                    TradeInfo incomingInfo{order->getOrderId(), order->getPrice(), tradeQuantity};
+                    TradeInfo restingInfo{resting->getOrderId(), bestPrice, tradeQuantity};
+                    trades.push_back(restingSide == OrderSide::SELL
+                        ? Trade{incomingInfo, restingInfo, bestPrice, OrderSide::BUY}
+                        : Trade{restingInfo, incomingInfo, bestPrice, OrderSide::SELL});
+
+                    if (resting->firesOco()) {
+                        resting->fireOco(ocoCancels);
+                    }
+                    if (order->firesOco()) {
+                        order->fireOco(ocoCancels);
+                    }
+                    if (order->isOcoCancelled()) {
+                        incomingCancelled = true;
+                    }
+                }
+
+                if (restingCancelled)
+                {
+                    std::cout << "[MATCHORDERS] " << sideName << " Order " << resting->getOrderId() << " cancelled by self-trade prevention" << "\n";
+                    resting->unlinkOco();
+                    bestLevel->remove(restingThreshold, restingLocation);
+                    orders_.erase(resting->getOrderId());
+                    noteRemoved(resting->getOrderId());
+                }
+                else if (resting->isFilled())
+                {
+                    std::cout << "[MATCHORDERS] " << sideName << " Order " << resting->getOrderId() << " fully filled, removing from book" << "\n";
+                    bestLevel->remove(restingThreshold, restingLocation);
+                    orders_.erase(resting->getOrderId());
+                    noteRemoved(resting->getOrderId());
+                }
+                return !order->isFilled() && !incomingCancelled;
+            };
+
+            AllocationPolicy::allocate(*bestLevel, location, *order, execute);
+            if (bestSource == LIMIT_SOURCE) {
+                markDepthDirty(restingSide, bestPrice);
+            } else {
+                markPegDirty(restingSide, bestSource, pegIts[bestSource]->first);
             }
-        }
-    }
-    // Handle unfilled FOK orders - these should be cancelled if they couldn't be fully matched
-    // Check ALL orders at all price levels, not just the first order at each level
-    std::vector<OrderId> fokOrdersToCancel;
-    
-    // Lambda to collect unfilled FOK orders from either bid or ask side
-    auto collectFokOrders = [&](const auto& sideMap, const std::string& sideName) {
-        for (const auto& [price, orders] : sideMap) {
-            for (const auto& order : orders) {
-                if (order->getOrderType() == OrderType::FOK && !order->isFilled()) {
-                    std::cout << "[MATCHORDERS] Found unfilled FOK " << sideName << " order " 
-                              << order->getOrderId() << " to cancel" << "\n";
-                    fokOrdersToCancel.push_back(order->getOrderId());
+
+            if (bestLevel->empty())
+            {
+                std::cout << "[MATCHORDERS] All " << sideName << "s at price " << bestPrice << " consumed, removing "
+                          << (bestSource == LIMIT_SOURCE ? "price level" : "peg bucket") << "\n";
+                if (bestSource == LIMIT_SOURCE) {
+                    levelIt = sideMap.erase(levelIt);
+                } else {
+                    pegIts[bestSource] = pegQueues[bestSource].erase(pegIts[bestSource]);
                 }
             }
+
+            // Cancel fired OCO siblings before anything else can trade with them. A cursor whose
+            // level a cancel empties steps past it first, so the walk resumes where it was
+            cancelOcoSiblings(ocoCancels, [&](const PriceLevel& level) {
+                if (levelIt != sideMap.end() && &levelIt->second == &level) {
+                    ++levelIt;
+                }
+                for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+                    if (pegIts[i] != pegQueues[i].end() && &pegIts[i]->second == &level) {
+                        ++pegIts[i];
+                    }
+                }
+            });
         }
     };
 
-    collectFokOrders(bids_, "bid");
-    collectFokOrders(asks_, "ask");
-    
-    // Cancel FOK orders after matching is complete to avoid recursion
-    for (OrderId orderId : fokOrdersToCancel) {
-        std::cout << "[MATCHORDERS] Cancelling unfilled FOK order " << orderId << "\n";
-        cancelOrder(orderId);
-    }
+    (order->getOrderSide() == OrderSide::BUY)
+        ? matchAgainst(asks_, askPegs_, OrderSide::SELL, "ask",
+                       [](Price orderPrice, Price askPrice) { return orderPrice >= askPrice; },
+                       [](Price p1, Price p2) { return p1 < p2; })
+        : matchAgainst(bids_, bidPegs_, OrderSide::BUY, "bid",
+                       [](Price orderPrice, Price bidPrice) { return orderPrice <= bidPrice; },
+                       [](Price p1, Price p2) { return p1 > p2; });
+
     std::cout << "[MATCHORDERS] Matching complete - generated " << trades.size() << " trade(s)" << "\n";
     return trades;
 }
 
-Trades OrderBook::addOrder(OrderPointer order)
+template<typename AllocationPolicy>
+Trades BasicOrderBook<AllocationPolicy>::addOrder(OrderPointer order)
+{
+    Trades trades = submitOrder(order);
+    processTrailingStops(trades);
+    publishMarketData();
+    return trades;
+}
+
+template<typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::processTrailingStops(Trades& trades, std::size_t firstUnprocessed)
+{
+    std::vector<OrderPointer> triggered;
+    // Index loop: trades from triggered stops are appended and picked up by later iterations
+    for (std::size_t i = firstUnprocessed; i < trades.size(); ++i) {
+        Price price = trades[i].getPrice();
+        lastTradePrice_ = price;
+        lastTradeQuantity_ = trades[i].getBid().quantity_.get();
+        buyStops_.onTrade(price, triggered);
+        sellStops_.onTrade(price, triggered);
+
+        for (const OrderPointer& stop : triggered) {
+            std::cout << "[STOPS] Trailing stop " << stop->getOrderId() << " triggered by trade @ " << price
+                      << " - submitting as limit order @ " << stop->getPrice() << "\n";
+            stop->clearTrailingStop();
+            noteRemoved(stop->getOrderId());
+            Trades stopTrades = submitOrder(stop);
+            trades.insert(trades.end(), stopTrades.begin(), stopTrades.end());
+        }
+        triggered.clear();
+    }
+}
+
+template<typename AllocationPolicy>
+Trades BasicOrderBook<AllocationPolicy>::submitOrder(const OrderPointer& order)
 {
     std::cout << "[ADDORDER] Adding new order - ID: " << order->getOrderId() 
               << ", Side: " << (order->getOrderSide() == OrderSide::BUY ? "BUY" : "SELL")
@@ -163,96 +678,615 @@ Trades OrderBook::addOrder(OrderPointer order)
               << ", Price: " << order->getPrice() 
               << ", Quantity: " << order->getRemainingQuantity() << "\n";
     
-    if (orders_.find(order->getOrderId()) != orders_.end()){ // C++17 compatible
+    if (orderExists(order->getOrderId())){
         std::cout << "[ADDORDER] Order ID " << order->getOrderId() << " already exists - rejecting" << "\n";
         return {};
     }
+    if (order->isOcoCancelled()){
+        std::cout << "[ADDORDER] OCO group of Order ID " << order->getOrderId() << " already fired - rejecting" << "\n";
+        return {};
+    }
+    if (order->isTrailingStop()){
+        if (order->isPegged()) {
+            std::cout << "[ADDORDER] Trailing stops cannot be pegged - rejecting Order ID " << order->getOrderId() << "\n";
+            return {};
+        }
+        auto& stops = (order->getOrderSide() == OrderSide::BUY) ? buyStops_ : sellStops_;
+        stops.add(order, lastTradePrice_);
+        std::cout << "[ADDORDER] Parked trailing stop " << order->getOrderId() << " with offset "
+                  << order->getTrailingOffset() << " (" << stops.size() << " parked on this side)" << "\n";
+        return {};
+    }
+    if (order->isPegged() && order->getOrderType() != OrderType::GTC){
+        std::cout << "[ADDORDER] Pegged orders must be GTC - rejecting Order ID " << order->getOrderId() << "\n";
+        return {};
+    }
+    if (order->getOrderType() == OrderType::FOK && auctionActive_){
+        std::cout << "[ADDORDER] FOK orders are not accepted during an auction - rejecting Order ID " << order->getOrderId() << "\n";
+        return {};
+    }
     if (order->getOrderType() == OrderType::FOK && !canMatch(order->getOrderSide(), order->getPrice())){
         std::cout << "[ADDORDER] FOK order cannot be matched - rejecting Order ID " << order->getOrderId() << "\n";
         return {};
     }
 
+    order->setSequence(nextSequence_++);
+
+    // Pegged orders are passive: they rest at their reference and only trade when hit.
+    // During an auction every order rests until the uncross.
+    bool cancelled = false;
+    Trades trades = (order->isPegged() || auctionActive_) ? Trades{} : matchOrders(order, cancelled);
+
+    if (cancelled) {
+        std::cout << "[ADDORDER] Order " << order->getOrderId() << " cancelled by "
+                  << (order->isOcoCancelled() ? "OCO sibling" : "self-trade prevention") << "\n";
+        return trades;
+    }
+    if (order->isFilled()) {
+        std::cout << "[ADDORDER] Order " << order->getOrderId() << " fully filled on entry" << "\n";
+        return trades;
+    }
+    // Unfilled FOK remainders never rest in the book
+    if (order->getOrderType() == OrderType::FOK) {
+        std::cout << "[ADDORDER] Cancelling unfilled FOK order " << order->getOrderId() << "\n";
+        return trades;
+    }
+
     // Lambda to handle adding orders to either bid or ask side
-    auto addToSide = [&](auto& sideMap, const std::string& sideName) -> OrderPointers::iterator {
-        auto& orders = sideMap[order->getPrice()];
-        orders.push_back(order);
-        auto iterator = std::next(orders.begin(), orders.size()-1);
+    auto addToSide = [&](auto& sideMap, auto& pegQueues, const std::string& sideName) {
+        if (order->isPegged()) {
+            auto& level = pegQueues[static_cast<std::size_t>(order->getPegType()) - 1][order->getPegOffset()];
+            std::cout << "[ADDORDER] Added pegged " << sideName << " order with offset " << order->getPegOffset()
+                      << " (now " << level.size() + 1 << " orders at this offset)" << "\n";
+            level.add(order);
+            markPegDirty(*order);
+            return;
+        }
+        auto& level = sideMap[order->getPrice()];
+        level.add(order);
+        markDepthDirty(order->getOrderSide(), order->getPrice());
         std::cout << "[ADDORDER] Added " << sideName << " order to " << sideName << " level " 
-                  << order->getPrice() << " (now " << orders.size() << " orders at this level)" << "\n";
-        return iterator;
+                  << order->getPrice() << " (now " << level.size() << " orders at this level)" << "\n";
     };
 
-    OrderPointers::iterator iterator = (order->getOrderSide() == OrderSide::BUY)
-        ? addToSide(bids_, "BUY")
-        : addToSide(asks_, "SELL");
-    orders_.insert({order->getOrderId(), OrderEntry{ order, iterator}});
+    (order->getOrderSide() == OrderSide::BUY)
+        ? addToSide(bids_, bidPegs_, "BUY")
+        : addToSide(asks_, askPegs_, "SELL");
+    orders_.insert({order->getOrderId(), order});
     
-    std::cout << "[ADDORDER] Order successfully added to book, initiating matching..." << "\n";
-    return matchOrders();
+    std::cout << "[ADDORDER] Order successfully added to book" << "\n";
+    return trades;
 }
 
-void OrderBook::cancelOrder(OrderId orderId){
-    if(orders_.find(orderId) == orders_.end()){
-        return;
+template<typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::cancelOrder(OrderId orderId){
+    if (removeOrder(orderId)) {
+        publishMarketData();
     }
+}
 
-    const auto& [order, iterator] = orders_.at(orderId);
-    // Capture necessary data before erasing from orders_
-    OrderSide orderSide = order->getOrderSide();
-    Price orderPrice = order->getPrice();
-    auto iteratorCopy = iterator;  // Copy the iterator before orders_.erase() invalidates it
-    orders_.erase(orderId);
+template<typename AllocationPolicy>
+bool BasicOrderBook<AllocationPolicy>::reduceOrder(OrderId orderId, Quantity quantity)
+{
+    auto entry = orders_.find(orderId);
+    OrderPointer order = (entry != orders_.end())
+        ? entry->second
+        : (buyStops_.contains(orderId) ? buyStops_.find(orderId) : sellStops_.find(orderId));
+    if (!order) {
+        return false;
+    }
+    if (quantity >= order->getRemainingQuantity()) {
+        cancelOrder(orderId);
+        return true;
+    }
 
-    // Lambda to handle removing orders from either bid or ask side
-    auto removeFromSide = [&](auto& sideMap) {
-        auto& orders = sideMap.at(orderPrice);
-        orders.erase(iteratorCopy);  // Use the copied iterator
-        if(orders.empty()){
-            sideMap.erase(orderPrice);
+    std::uint32_t threshold = order->getExecutionThreshold();
+    order->decrement(quantity);
+    if (entry == orders_.end()) {
+        return true; // Parked stops are not in the book or its market data
+    }
+
+    order->level_->reduce(order->location_, threshold, quantity.get());
+    if (order->isPegged()) {
+        markPegDirty(*order);
+    } else {
+        markDepthDirty(order->getOrderSide(), order->getPrice());
+    }
+    publishMarketData();
+    return true;
+}
+
+template<typename AllocationPolicy>
+bool BasicOrderBook<AllocationPolicy>::removeOrder(OrderId orderId){
+    auto entry = orders_.find(orderId);
+    if(entry == orders_.end()){
+        // Not resting - it may be a parked trailing stop
+        OrderPointer stop = buyStops_.find(orderId);
+        auto& stops = stop ? buyStops_ : sellStops_;
+        if (!stop) {
+            stop = sellStops_.find(orderId);
+        }
+        if (stop) {
+            stop->unlinkOco();
+            stops.cancel(orderId);
+            noteRemoved(orderId);
+        }
+        return stop != nullptr;
+    }
+
+    OrderPointer order = entry->second;  // Keeps the order alive until it is out of the book
+    order->unlinkOco();
+    removeResting(*order);
+    return true;
+}
+
+template<typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::removeResting(Order& order)
+{
+    PriceLevel& level = *order.level_;
+    level.remove(order.getExecutionThreshold(), order.location_);
+
+    // Lambda to drop the order's level once it is empty and record the depth change
+    auto removeFromSide = [&](auto& sideMap, auto& pegQueues) {
+        if (order.isPegged()) {
+            markPegDirty(order);
+            if (level.empty()) {
+                pegQueues[static_cast<std::size_t>(order.getPegType()) - 1].erase(order.getPegOffset());
+            }
+        } else {
+            markDepthDirty(order.getOrderSide(), order.getPrice());
+            if (level.empty()) {
+                sideMap.erase(order.getPrice());
+            }
         }
     };
 
-    (orderSide == OrderSide::SELL) ? removeFromSide(asks_) : removeFromSide(bids_);
+    (order.getOrderSide() == OrderSide::SELL) ? removeFromSide(asks_, askPegs_) : removeFromSide(bids_, bidPegs_);
+    orders_.erase(order.getOrderId());
+    noteRemoved(order.getOrderId());
 }
 
-Trades OrderBook::matchOrder(OrderModifier order)
+template<typename AllocationPolicy>
+template<typename BeforeEmpty>
+void BasicOrderBook<AllocationPolicy>::cancelOcoSiblings(std::vector<Order*>& siblings, BeforeEmpty beforeEmpty)
 {
-    if(orders_.find(order.getOrderId()) == orders_.end()){
+    for (Order* sibling : siblings) {
+        std::cout << "[OCO] Cancelling OCO sibling " << sibling->getOrderId() << "\n";
+        if (sibling->level_ != nullptr) {
+            if (sibling->level_->size() == 1) {
+                beforeEmpty(*sibling->level_);
+            }
+            removeResting(*sibling);
+        } else if (sibling->isTrailingStop()) {
+            (sibling->getOrderSide() == OrderSide::BUY ? buyStops_ : sellStops_).cancel(sibling->getOrderId());
+            noteRemoved(sibling->getOrderId());
+        }
+        // Otherwise it is the incoming order or has not been submitted; addOrder rejects it
+    }
+    siblings.clear();
+}
+
+template<typename AllocationPolicy>
+Trades BasicOrderBook<AllocationPolicy>::matchOrder(OrderModifier order)
+{
+    auto entry = orders_.find(order.getOrderId());
+    // Hold the existing order so its type, fill constraint, peg and trailing offset survive the cancel
+    OrderPointer existingOrder = (entry != orders_.end())
+        ? entry->second
+        : (buyStops_.contains(order.getOrderId()) ? buyStops_.find(order.getOrderId()) : sellStops_.find(order.getOrderId()));
+    if(!existingOrder){
         return{};
     }
+    OrderPointer replacement = order.toOrderPointer(*existingOrder);
+    replacement->replaceInOco(*existingOrder);
+    removeOrder(order.getOrderId());
+    return addOrder(replacement);
+}
 
-    const auto& [existingOrder, _] = orders_.at(order.getOrderId());
-    // Capture the order type before cancelling the order
-    OrderType existingOrderType = existingOrder->getOrderType();
-    cancelOrder(order.getOrderId());
-    return addOrder(order.toOrderPointer(existingOrderType));
+template<typename AllocationPolicy>
+auto BasicOrderBook<AllocationPolicy>::computeAuctionEquilibrium(std::optional<Price> referencePrice) const
+    -> std::optional<AuctionEquilibrium>
+{
+    std::uint64_t totalBidDepth = 0;
+    for (const auto& [price, level] : bids_) {
+        totalBidDepth += level.unconstrainedQuantity();
+    }
+
+    // Walk every price ascending once: bid depth at p is everything not yet passed below p,
+    // ask depth at p is everything passed so far including p
+    std::uint64_t bidsBelow = 0;
+    std::uint64_t asksAtOrBelow = 0;
+    std::uint64_t bestVolume = 0;
+    std::uint64_t bestImbalance = 0;
+    std::vector<AuctionEquilibrium> tied;
+
+    auto bidIt = bids_.rbegin();
+    auto askIt = asks_.begin();
+    while (bidIt != bids_.rend() || askIt != asks_.end())
+    {
+        Price price = (askIt == asks_.end() || (bidIt != bids_.rend() && bidIt->first < askIt->first))
+            ? bidIt->first
+            : askIt->first;
+
+        std::uint64_t bidQuantityHere = 0;
+        if (bidIt != bids_.rend() && bidIt->first == price) {
+            bidQuantityHere = (bidIt++)->second.unconstrainedQuantity();
+        }
+        if (askIt != asks_.end() && askIt->first == price) {
+            asksAtOrBelow += (askIt++)->second.unconstrainedQuantity();
+        }
+
+        std::uint64_t bidDepth = totalBidDepth - bidsBelow;
+        std::uint64_t volume = std::min(bidDepth, asksAtOrBelow);
+        std::int64_t surplus = static_cast<std::int64_t>(bidDepth) - static_cast<std::int64_t>(asksAtOrBelow);
+        std::uint64_t imbalance = static_cast<std::uint64_t>(surplus < 0 ? -surplus : surplus);
+        bidsBelow += bidQuantityHere;
+
+        if (volume == 0 || volume < bestVolume || (volume == bestVolume && imbalance > bestImbalance)) {
+            continue;
+        }
+        if (volume > bestVolume || imbalance < bestImbalance) {
+            tied.clear();
+            bestVolume = volume;
+            bestImbalance = imbalance;
+        }
+        tied.push_back(AuctionEquilibrium{price, volume, surplus});
+    }
+
+    if (tied.empty()) {
+        return std::nullopt;
+    }
+
+    // Market pressure: a buy surplus everywhere pushes the price up, a sell surplus pushes it down
+    bool allBuySurplus = std::all_of(tied.begin(), tied.end(), [](const AuctionEquilibrium& e) { return e.surplus_ > 0; });
+    bool allSellSurplus = std::all_of(tied.begin(), tied.end(), [](const AuctionEquilibrium& e) { return e.surplus_ < 0; });
+    if (allBuySurplus) {
+        return tied.back();
+    }
+    if (allSellSurplus) {
+        return tied.front();
+    }
+    if (referencePrice) {
+        auto distance = [&](const AuctionEquilibrium& e) {
+            return std::abs(static_cast<std::int64_t>(e.price_.get()) - referencePrice->get());
+        };
+        return *std::min_element(tied.begin(), tied.end(),
+            [&](const AuctionEquilibrium& a, const AuctionEquilibrium& b) { return distance(a) < distance(b); });
+    }
+    return tied[(tied.size() - 1) / 2];
 }
 
-OrderBookBAA OrderBook::getOrderBookLevelInfos() const {
+template<typename AllocationPolicy>
+Trades BasicOrderBook<AllocationPolicy>::uncrossAuction(std::optional<Price> referencePrice)
+{
+    std::cout << "[AUCTION] Uncrossing auction with " << orders_.size() << " order(s) in book" << "\n";
+    auctionActive_ = false;
+
+    auto equilibrium = computeAuctionEquilibrium(referencePrice);
+    if (!equilibrium) {
+        std::cout << "[AUCTION] Book does not cross - no uncross trades" << "\n";
+        return {};
+    }
+    Price auctionPrice = equilibrium->price_;
+    std::cout << "[AUCTION] Equilibrium price: " << auctionPrice << ", executable volume: " << equilibrium->volume_
+              << ", surplus: " << equilibrium->surplus_ << "\n";
+
+    Trades trades;
+    std::uint64_t remainingVolume = equilibrium->volume_;
+    auto bidIt = bids_.begin();
+    auto askIt = asks_.begin();
+
+    // Lambda to step past levels whose unconstrained orders are exhausted
+    auto nextEligible = [](auto& sideMap, auto& levelIt) -> std::optional<OrderPointers::iterator> {
+        while (levelIt != sideMap.end()) {
+            if (auto front = levelIt->second.frontUnconstrained()) {
+                return front;
+            }
+            levelIt = levelIt->second.empty() ? sideMap.erase(levelIt) : std::next(levelIt);
+        }
+        return std::nullopt;
+    };
+
+    // Lambda to drop a filled order from its level and the lookup table
+    auto removeFilled = [&](auto& sideMap, auto& levelIt, OrderPointers::iterator location) {
+        OrderId orderId = (*location)->getOrderId();
+        levelIt->second.remove(0, location);
+        orders_.erase(orderId);
+        noteRemoved(orderId);
+        if (levelIt->second.empty()) {
+            levelIt = sideMap.erase(levelIt);
+        }
+    };
+
+    // Both sides are consumed best-first; the volume bound keeps every allocation at or through the auction price
+    while (remainingVolume > 0)
+    {
+        auto bidLocation = nextEligible(bids_, bidIt);
+        auto askLocation = nextEligible(asks_, askIt);
+        if (!bidLocation || !askLocation) {
+            break;
+        }
+        OrderPointer bid = **bidLocation;
+        OrderPointer ask = **askLocation;
+        Quantity tradeQuantity = std::min(bid->getRemainingQuantity(), ask->getRemainingQuantity());
+        if (tradeQuantity.get() > remainingVolume) {
+            tradeQuantity = Quantity(static_cast<std::uint32_t>(remainingVolume));
+        }
+
+        bid->fill(tradeQuantity);
+        ask->fill(tradeQuantity);
+        bidIt->second.reduce(*bidLocation, 0, tradeQuantity.get());
+        askIt->second.reduce(*askLocation, 0, tradeQuantity.get());
+        markDepthDirty(OrderSide::BUY, bidIt->first);
+        markDepthDirty(OrderSide::SELL, askIt->first);
+        remainingVolume -= tradeQuantity.get();
+        trades.push_back(
+            Trade{
+                TradeInfo{bid->getOrderId(), auctionPrice, tradeQuantity},
+                TradeInfo{ask->getOrderId(), auctionPrice, tradeQuantity},
+                auctionPrice
+            }
+        );
+
+        std::vector<Order*> ocoCancels;
+        if (bid->firesOco()) {
+            bid->fireOco(ocoCancels);
+        }
+        if (ask->firesOco()) {
+            ask->fireOco(ocoCancels);
+        }
+
+        if (bid->isFilled()) {
+            removeFilled(bids_, bidIt, *bidLocation);
+        }
+        if (ask->isFilled()) {
+            removeFilled(asks_, askIt, *askLocation);
+        }
+
+        // Fired siblings leave before the next allocation; a cursor on a level they empty steps past it
+        cancelOcoSiblings(ocoCancels, [&](const PriceLevel& level) {
+            if (bidIt != bids_.end() && &bidIt->second == &level) {
+                ++bidIt;
+            }
+            if (askIt != asks_.end() && &askIt->second == &level) {
+                ++askIt;
+            }
+        });
+    }
+
+    std::cout << "[AUCTION] Uncross complete - generated " << trades.size() << " trade(s) at " << auctionPrice
+              << ", " << orders_.size() << " order(s) remain" << "\n";
+    processTrailingStops(trades);
+    publishMarketData();
+    return trades;
+}
+
+template<typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::publishTopOfBook()
+{
+    // Lambda to find one side's best price and the quantity there, pegs at their effective price included
+    auto touch = [&](const auto& sideMap, const auto& pegQueues, OrderSide side,
+                     std::int32_t& price, std::uint64_t& quantity) {
+        bool found = !sideMap.empty();
+        price = found ? sideMap.begin()->first.get() : 0;
+        quantity = found ? sideMap.begin()->second.totalQuantity() : 0;
+        auto better = sideMap.key_comp();
+        PegPricing pricing = getPegPricing(side);
+        for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+            // Buckets are ordered best offset first; several may be clamped onto the same price
+            for (const auto& [offset, level] : pegQueues[i]) {
+                auto pegPrice = pricing.price(i, offset);
+                if (!pegPrice) {
+                    continue;
+                }
+                if (!found || better(*pegPrice, Price(price))) {
+                    found = true;
+                    price = pegPrice->get();
+                    quantity = level.totalQuantity();
+                } else if (pegPrice->get() == price) {
+                    quantity += level.totalQuantity();
+                } else {
+                    break;
+                }
+            }
+        }
+    };
+
+    TopOfBook top{};
+    touch(bids_, bidPegs_, OrderSide::BUY, top.bidPrice_, top.bidQuantity_);
+    touch(asks_, askPegs_, OrderSide::SELL, top.askPrice_, top.askQuantity_);
+    top.lastTradePrice_ = lastTradePrice_ ? lastTradePrice_->get() : 0;
+    top.lastTradeQuantity_ = lastTradeQuantity_;
+    top.sequence_ = topSequence_;
+    topOfBook_.store(top);
+}
+
+template<typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::publishMarketData()
+{
+    if (!topOfBookEnabled_ && !depthEnabled_) {
+        return;
+    }
+    topSequence_++;
+    if (topOfBookEnabled_) {
+        publishTopOfBook();
+    }
+    if (depthEnabled_) {
+        publishDepth();
+    }
+}
+
+template<typename AllocationPolicy>
+void BasicOrderBook<AllocationPolicy>::publishDepth()
+{
+    // Lambda to turn one side's peg changes into depth marks. While the side's pricing is what the
+    // last publish used, each changed bucket dirties just its effective price; once a reference
+    // (or the clamp) moves, every peg price may have changed and the side is rebuilt.
+    auto syncPegs = [&](const auto& pegQueues, OrderSide side, auto& dirty, std::optional<PegPricing>& published) {
+        bool holdsPegs = std::any_of(pegQueues.begin(), pegQueues.end(), [](const auto& queue) { return !queue.empty(); });
+        if (!holdsPegs && !published) {
+            dirty.clear();
+            return;
+        }
+        PegPricing pricing = getPegPricing(side);
+        if (published && !(*published == pricing)) {
+            depth_.markRebuild(side == OrderSide::BUY);
+        } else {
+            for (const auto& [reference, offset] : dirty) {
+                if (auto price = pricing.price(reference, offset)) {
+                    markDepthDirty(side, *price);
+                }
+            }
+        }
+        dirty.clear();
+        published = holdsPegs ? std::optional<PegPricing>(pricing) : std::nullopt;
+    };
+    syncPegs(bidPegs_, OrderSide::BUY, dirtyBidPegs_, bidPegsInDepth_);
+    syncPegs(askPegs_, OrderSide::SELL, dirtyAskPegs_, askPegsInDepth_);
+
+    // Lambda to bring one side of a buffer up to date
+    auto refreshSide = [&](const auto& sideMap, const auto& pegQueues, OrderSide side, std::vector<DepthLevel>& levels,
+                           const std::vector<std::int32_t>& stale, bool rebuild) {
+        if (rebuild) {
+            levels.clear();
+            forEachLevel(sideMap, pegQueues, side, [&](Price price, std::uint64_t quantity) {
+                levels.push_back({price.get(), quantity});
+            });
+            return;
+        }
+        auto better = [side](std::int32_t a, std::int32_t b) { return side == OrderSide::BUY ? a > b : a < b; };
+        bool pegged = (side == OrderSide::BUY) ? bidPegsInDepth_.has_value() : askPegsInDepth_.has_value();
+        for (std::int32_t price : stale) {
+            auto live = sideMap.find(Price(price));
+            std::uint64_t quantity = live == sideMap.end() ? 0 : live->second.totalQuantity();
+            if (pegged) {
+                quantity += pegQuantityAt(pegQueues, side == OrderSide::BUY ? *bidPegsInDepth_ : *askPegsInDepth_, Price(price));
+            }
+            auto it = std::lower_bound(levels.begin(), levels.end(), price,
+                                       [&](const DepthLevel& level, std::int32_t key) { return better(level.price_, key); });
+            bool present = it != levels.end() && it->price_ == price;
+            if (quantity == 0) {
+                if (present) {
+                    levels.erase(it);
+                }
+            } else if (present) {
+                it->quantity_ = quantity;
+            } else {
+                levels.insert(it, DepthLevel{price, quantity});
+            }
+        }
+    };
+
+    depthPending_ = !depth_.publish(topSequence_, [&](DepthBuffers::Buffer& buffer) {
+        refreshSide(bids_, bidPegs_, OrderSide::BUY, buffer.depth_.bids_, buffer.staleBids_, buffer.rebuildBids_);
+        refreshSide(asks_, askPegs_, OrderSide::SELL, buffer.depth_.asks_, buffer.staleAsks_, buffer.rebuildAsks_);
+    });
+}
+
+template<typename AllocationPolicy>
+template<typename SideMap, typename PegQueues, typename Emit>
+void BasicOrderBook<AllocationPolicy>::forEachLevel(const SideMap& sideMap, const PegQueues& pegQueues, OrderSide side,
+                                                    Emit emit) const
+{
+    // Each reference's buckets are ordered best offset first, so their clamped prices are sorted
+    // too; the limit levels and the three bucket streams are merged without building anything
+    PegPricing pricing = getPegPricing(side);
+    std::array<typename PegQueues::value_type::const_iterator, PEG_REFERENCE_COUNT> pegs;
+    for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+        pegs[i] = pricing.references_[i] ? pegQueues[i].begin() : pegQueues[i].end();
+        while (pegs[i] != pegQueues[i].end() && !pricing.price(i, pegs[i]->first)) {
+            ++pegs[i];  // Unpriced buckets lead a sell side without bids
+        }
+    }
+
+    // Lambda to price a stream's current bucket; std::nullopt once the stream is exhausted
+    auto pegPrice = [&](std::size_t i) {
+        return (pegs[i] == pegQueues[i].end()) ? std::nullopt : pricing.price(i, pegs[i]->first);
+    };
+
+    auto better = sideMap.key_comp();
+    auto level = sideMap.begin();
+    while (true) {
+        std::optional<Price> price;
+        if (level != sideMap.end()) {
+            price = level->first;
+        }
+        for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+            auto candidate = pegPrice(i);
+            if (candidate && (!price || better(*candidate, *price))) {
+                price = candidate;
+            }
+        }
+        if (!price) {
+            return;
+        }
+
+        std::uint64_t totalQty = 0;
+        if (level != sideMap.end() && level->first == *price) {
+            totalQty += (level++)->second.totalQuantity();
+        }
+        for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+            for (auto candidate = pegPrice(i); candidate && *candidate == *price; candidate = pegPrice(i)) {
+                totalQty += (pegs[i]++)->second.totalQuantity();
+            }
+        }
+        emit(*price, totalQty);
+    }
+}
+
+template<typename AllocationPolicy>
+template<typename PegQueues>
+std::uint64_t BasicOrderBook<AllocationPolicy>::pegQuantityAt(const PegQueues& pegQueues, const PegPricing& pricing,
+                                                              Price price) const
+{
+    std::uint64_t quantity = 0;
+    for (std::size_t i = 0; i < PEG_REFERENCE_COUNT; ++i) {
+        if (!pricing.references_[i]) {
+            continue;
+        }
+        if (pricing.limit_ && price.get() == *pricing.limit_) {
+            // Every bucket at or through the clamp prices here; they lead the queue
+            for (auto bucket = pegQueues[i].begin();
+                 bucket != pegQueues[i].end() && pricing.price(i, bucket->first) == price; ++bucket) {
+                quantity += bucket->second.totalQuantity();
+            }
+            continue;
+        }
+        auto bucket = pegQueues[i].find(price.get() - *pricing.references_[i]);
+        if (bucket != pegQueues[i].end() && pricing.price(i, bucket->first) == price) {
+            quantity += bucket->second.totalQuantity();
+        }
+    }
+    return quantity;
+}
+
+template<typename AllocationPolicy>
+OrderBookBAA BasicOrderBook<AllocationPolicy>::getOrderBookLevelInfos() const {
     OrderBookLevels bidlevels;
     OrderBookLevels asklevels;
     bidlevels.reserve(orders_.size());
     asklevels.reserve(orders_.size());
 
-        auto createLevelInfos = [](Price price, const OrderPointers& orders){
-        std::uint32_t totalQty = std::accumulate(orders.begin(), orders.end(), 0u,
-            [](std::uint32_t runningSum, const OrderPointer& order)
-                {return runningSum + order->getRemainingQuantity().get(); });
+        auto createLevelInfos = [](Price price, std::uint64_t totalQty){
         // Handle case where totalQty is 0 (no orders at this level)
         if (totalQty == 0) {
             return OrderBookLevel{price, Quantity(1)}; // Use minimum valid quantity
         }
-        return OrderBookLevel{price, Quantity(totalQty)};
+        return OrderBookLevel{price, Quantity(static_cast<std::uint32_t>(totalQty))};
             };
 
-    for (const auto& [price, orders] : bids_){
-        bidlevels.push_back(createLevelInfos(price, orders));
-    } 
-    
-    for (const auto& [price, orders] : asks_){
-        asklevels.push_back(createLevelInfos(price, orders));
-    }
-    
+    // Aggregate limit levels, folding pegged orders in at their current effective price
+    forEachLevel(bids_, bidPegs_, OrderSide::BUY, [&](Price price, std::uint64_t totalQty) {
+        bidlevels.push_back(createLevelInfos(price, totalQty));
+    });
+    forEachLevel(asks_, askPegs_, OrderSide::SELL, [&](Price price, std::uint64_t totalQty) {
+        asklevels.push_back(createLevelInfos(price, totalQty));
+    });
 
     return OrderBookBAA {bidlevels, asklevels}; 
 }
+
+// Explicit instantiations for the supported allocation policies
+template class BasicOrderBook<FifoAllocation>;
+template class BasicOrderBook<ProRataAllocation>;
+template class BasicOrderBook<FifoTopOrderAllocation>;
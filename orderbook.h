@@ -12,7 +12,12 @@
 #include <vector>       // Trade collections and order book snapshots
 #include <numeric>      // Quantity aggregation for level summaries
 #include <memory>       // Smart pointers
+#include <optional>     // Eligible order lookups and peg reference prices
+#include <array>        // Peg queues indexed by reference type
+#include <algorithm>    // std::min for execution thresholds
 #include "types.h"      // Strong type definitions for Price, Quantity, OrderId
+#include "seqlock.h"    // Top of book publication to other threads
+#include "depth_buffers.h" // Depth publication to other threads
 
 /**
  * Order lifecycle behavior types
@@ -23,6 +28,50 @@ enum class OrderType
     FOK //fill or kill - must execute immediately and completely or be rejected
 };
 
+/**
+ * Per-execution quantity constraints carried by an order
+ * Constrained orders only trade with counterparties large enough to satisfy them
+ */
+enum class FillConstraint
+{
+    NONE,         // any execution size is acceptable
+    ALL_OR_NONE,  // a single execution must fill the entire remaining quantity
+    MIN_QUANTITY  // every execution must be at least the minimum quantity (or the remainder if smaller)
+};
+
+/**
+ * Reference price a pegged order tracks
+ * Pegged orders are priced at reference + offset whenever the book evaluates them
+ */
+enum class PegType
+{
+    NONE,    // plain limit order
+    PRIMARY, // same-side touch (best bid for buys, best ask for sells)
+    MARKET,  // opposite-side touch (best ask for buys, best bid for sells)
+    MID      // midpoint of the touch (rounded down for buys, up for sells)
+};
+
+/**
+ * Action taken when an incoming order would trade against a resting order of the same owner
+ */
+enum class SelfTradePrevention
+{
+    NONE,          // self-trades are allowed
+    CANCEL_NEWEST, // cancel the incoming order's remainder, leave the resting order
+    CANCEL_OLDEST, // cancel the resting order and keep matching the incoming order
+    CANCEL_BOTH,   // cancel the resting order and the incoming order's remainder
+    DECREMENT      // reduce both by the smaller quantity without trading; cancel whichever reaches zero
+};
+
+/**
+ * When a one-cancels-other group fires
+ */
+enum class OcoMode
+{
+    ON_FULL_FILL, // a member filling completely cancels the rest
+    ON_ANY_FILL   // any execution of a member cancels the rest
+};
+
 /**
  * Market side designation
  */
@@ -58,11 +107,32 @@ class OrderBookBAA
     asks_{asks}
     {}
 
+    const OrderBookLevels& getBids() const { return bids_; }
+    const OrderBookLevels& getAsks() const { return asks_; }
+
     private:
     OrderBookLevels bids_; // Bid levels (highest to lowest price)
     OrderBookLevels asks_; // Ask levels (lowest to highest price)
 };
 
+/**
+ * Best bid/ask and last execution as published by the book after each state change
+ * An empty side has zero price and quantity; pegged orders count at their effective price
+ */
+struct TopOfBook
+{
+    std::int32_t bidPrice_;           // Best bid (0 if none)
+    std::int32_t askPrice_;           // Best ask (0 if none)
+    std::uint64_t bidQuantity_;       // Quantity resting at the best bid
+    std::uint64_t askQuantity_;       // Quantity resting at the best ask
+    std::int32_t lastTradePrice_;     // Most recent execution (0 before the first)
+    std::uint32_t lastTradeQuantity_;
+    std::uint64_t sequence_;          // State changes published so far
+};
+
+class PriceLevel;
+template<typename AllocationPolicy> class BasicOrderBook;
+
 /**
  * Individual order with partial fill tracking
  * Immutable after creation except for quantity fills
@@ -70,14 +140,26 @@ class OrderBookBAA
 class Order
 {
     public:
-    Order(OrderId id, OrderSide side, OrderType type, Price price, Quantity quantity):
+    Order(OrderId id, OrderSide side, OrderType type, Price price, Quantity quantity,
+          FillConstraint constraint = FillConstraint::NONE, std::uint32_t minimumQuantity = 0):
     id_{id},
     side_{side},
     type_{type},
     price_{price},
     initialQuantity_{quantity},
-    remainingQuantity_{quantity}
-    {}
+    remainingQuantity_{quantity},
+    constraint_{constraint},
+    minimumQuantity_{minimumQuantity}
+    {
+        if (constraint_ == FillConstraint::MIN_QUANTITY && minimumQuantity_ == 0) {
+            throw std::invalid_argument("Minimum quantity must be positive");
+        }
+    }
+
+    // OCO siblings point at each other, so an order cannot be copied and unlinks itself on destruction
+    Order(const Order&) = delete;
+    Order& operator=(const Order&) = delete;
+    ~Order() { unlinkOco(); }
     
     // Accessors for order properties
     OrderId getOrderId() const { return id_; }
@@ -86,8 +168,108 @@ class Order
     Price getPrice() const { return price_; }
     Quantity getInitialQuantity() const { return initialQuantity_; }
     Quantity getRemainingQuantity() const { return remainingQuantity_; }
-    Quantity getFilledQuantity() const { return initialQuantity_ - remainingQuantity_; }
+    Quantity getFilledQuantity() const { return Quantity(initialQuantity_.get() - remainingQuantity_.get() - decrementedQuantity_); }
     bool isFilled() const { return remainingQuantity_.get() == 0; }
+    FillConstraint getFillConstraint() const { return constraint_; }
+    std::uint32_t getMinimumQuantity() const { return minimumQuantity_; }
+    std::uint64_t getSequence() const { return sequence_; }
+    void setSequence(std::uint64_t sequence) { sequence_ = sequence; }
+    OwnerId getOwner() const { return owner_; }
+    PegType getPegType() const { return pegType_; }
+    std::int32_t getPegOffset() const { return pegOffset_; }
+    bool isPegged() const { return pegType_ != PegType::NONE; }
+    std::int32_t getTrailingOffset() const { return trailingOffset_; }
+    bool isTrailingStop() const { return trailingOffset_ != 0; }
+
+    /**
+     * Make the order a trailing stop (must be called before the order is added)
+     * The stop triggers once the last trade moves offset ticks against the best price seen
+     * since placement (down from the high for sells, up from the low for buys), and the
+     * order is then submitted as a regular limit order at its own price
+     * @param offset Trailing distance in ticks
+     * @throws std::invalid_argument if offset is not positive
+     */
+    void setTrailingStop(std::int32_t offset)
+    {
+        if (offset <= 0) {
+            throw std::invalid_argument("Trailing offset must be positive");
+        }
+        trailingOffset_ = offset;
+    }
+
+    /**
+     * Turn a triggered trailing stop into a plain order before it is routed to the book
+     */
+    void clearTrailingStop() { trailingOffset_ = 0; }
+
+    bool isOcoLinked() const { return ocoNext_ != nullptr; }
+    bool isOcoCancelled() const { return ocoCancelled_; }
+
+    /**
+     * Check whether an execution of this order fires its one-cancels-other group
+     */
+    bool firesOco() const
+    {
+        return ocoNext_ != nullptr && (ocoMode_ == OcoMode::ON_ANY_FILL || isFilled());
+    }
+
+    /**
+     * Fire this order's OCO group: every sibling is marked cancelled and the ring is dissolved
+     * @param siblings Receives the other members, which the book must then cancel
+     */
+    void fireOco(std::vector<Order*>& siblings);
+
+    /**
+     * Leave the OCO ring without affecting the other members
+     */
+    void unlinkOco();
+
+    /**
+     * Put this order into the OCO ring in place of another (used when an order is modified)
+     * @param replaced Current member; it leaves the ring
+     */
+    void replaceInOco(Order& replaced);
+
+    /**
+     * Attribute the order to an owner for self-trade prevention (must be called before the order is added)
+     * @param owner Owner/account id (NO_OWNER disables self-trade checks for this order)
+     * @throws std::invalid_argument if owner is RESERVED_OWNER
+     */
+    void setOwner(OwnerId owner)
+    {
+        if (owner == RESERVED_OWNER) {
+            throw std::invalid_argument("Owner id is reserved");
+        }
+        owner_ = owner;
+    }
+
+    /**
+     * Peg the order to a reference price (must be called before the order is added)
+     * While pegged the limit price is not used; the book prices the order at reference + offset
+     * @param type Reference to track
+     * @param offset Signed tick offset from the reference
+     */
+    void setPeg(PegType type, std::int32_t offset = 0)
+    {
+        pegType_ = type;
+        pegOffset_ = offset;
+    }
+
+    /**
+     * Smallest execution this order currently accepts
+     * @return 0 for unconstrained orders, otherwise the minimum fill size
+     */
+    std::uint32_t getExecutionThreshold() const
+    {
+        switch (constraint_) {
+            case FillConstraint::ALL_OR_NONE:
+                return remainingQuantity_.get();
+            case FillConstraint::MIN_QUANTITY:
+                return std::min(minimumQuantity_, remainingQuantity_.get());
+            default:
+                return 0;
+        }
+    }
 
     /**
      * Execute partial or complete fill against this order
@@ -96,6 +278,15 @@ class Order
      */
     void fill(Quantity quantity);
 
+    /**
+     * Shrink the order without trading (self-trade prevention decrement)
+     * Remaining quantity drops and the removed amount is tracked apart from fills, so the
+     * initial quantity keeps its original (positive) value and the filled quantity is unchanged
+     * @param quantity Amount to remove (must not exceed remaining quantity)
+     * @throws std::invalid_argument if quantity exceeds remaining
+     */
+    void decrement(Quantity quantity);
+
     private:
     OrderId id_;                    // Unique identifier
     OrderSide side_;                // BUY or SELL
@@ -103,11 +294,218 @@ class Order
     Price price_;                   // Limit price
     Quantity initialQuantity_;      // Original order size
     Quantity remainingQuantity_;    // Unfilled portion
+    std::uint32_t decrementedQuantity_{0}; // Removed without trading (not part of the filled quantity)
+    FillConstraint constraint_;     // NONE, ALL_OR_NONE or MIN_QUANTITY
+    std::uint32_t minimumQuantity_; // Minimum execution size for MIN_QUANTITY
+    std::uint64_t sequence_{0};     // Arrival sequence assigned by the book (time priority)
+    PegType pegType_{PegType::NONE};// Reference tracked by a pegged order
+    std::int32_t pegOffset_{0};     // Offset from the peg reference
+    OwnerId owner_{NO_OWNER};       // Owner/account for self-trade prevention
+    std::int32_t trailingOffset_{0};// Trailing stop distance (0 = not a stop)
+    Order* ocoPrev_{nullptr};       // Intrusive OCO ring - no lookup needed to reach siblings
+    Order* ocoNext_{nullptr};
+    OcoMode ocoMode_{OcoMode::ON_FULL_FILL};
+    bool ocoCancelled_{false};      // A sibling fired the group; the order must not trade
+    std::uint32_t levelSlot_{0};    // Position in its price level's match index
+    PriceLevel* level_{nullptr};    // Level (or peg bucket) the order rests in; null when not resting
+    std::list<std::shared_ptr<Order>>::iterator location_{}; // Position in that level's queue
+
+    friend class PriceLevel;
+    template<typename AllocationPolicy> friend class BasicOrderBook;
+    friend void linkOneCancelsOther(const std::vector<std::shared_ptr<Order>>& orders, OcoMode mode);
 };
 
 using OrderPointer = std::shared_ptr<Order>;
 using OrderPointers = std::list<OrderPointer>; //FIFO queue - could change to vector, will keep as list for now
 
+/**
+ * Link orders into a one-cancels-other group (before they are added)
+ * When one member fires, the book cancels the others inside the same matching pass.
+ * Orders already in another group leave it first.
+ * @param orders Group members (at least two)
+ * @param mode Whether a partial fill or only a full fill fires the group
+ * @throws std::invalid_argument if fewer than two orders are given
+ */
+void linkOneCancelsOther(const std::vector<OrderPointer>& orders, OcoMode mode);
+
+/**
+ * All orders resting at one price
+ * Unconstrained orders and AON/minimum-quantity orders sit in two FIFO queues. Once a
+ * constrained order rests here (or a constrained counterparty asks), a match index over
+ * arrival order is built: a tournament tree whose nodes keep the smallest execution threshold
+ * and the largest remaining quantity beneath them. A match descends only into subtrees that
+ * can hold an eligible order, so it never walks the queues, and a fill updates one leaf path.
+ */
+class PriceLevel
+{
+    public:
+    /**
+     * Append order to the back of its queue
+     * @param order Order to rest (sequence must already be assigned)
+     * @return Iterator to the order's position, stable until removal
+     */
+    OrderPointers::iterator add(const OrderPointer& order);
+
+    /**
+     * Remove order from its queue
+     * @param threshold Execution threshold the order is indexed under (0 = unconstrained queue)
+     * @param location Iterator returned by add()
+     */
+    void remove(std::uint32_t threshold, OrderPointers::iterator location);
+
+    /**
+     * Account for a fill or decrement of an order resting here (keeps the aggregates and the
+     * match index current; the order stays in its queue with its time priority)
+     * @param location Iterator of the reduced order (already filled or decremented)
+     * @param threshold Execution threshold the order had before the reduction
+     * @param quantity Amount removed from the order
+     */
+    void reduce(OrderPointers::iterator location, std::uint32_t threshold, std::uint32_t quantity);
+
+    /**
+     * Find the earliest order that can trade against a counterparty
+     * An order is eligible when its threshold is within counterRemaining and its remaining
+     * quantity covers counterThreshold. With unconstrained orders only and an unconstrained
+     * counterparty this is the queue front; otherwise the match index answers it.
+     * @param counterRemaining Remaining quantity of the counterparty
+     * @param counterThreshold Counterparty's own execution threshold (0 if unconstrained)
+     * @return Iterator to the matching order, or std::nullopt if none is eligible
+     */
+    std::optional<OrderPointers::iterator> findMatch(std::uint32_t counterRemaining, std::uint32_t counterThreshold);
+
+    bool empty() const { return unconstrained_.empty() && constrained_.empty(); }
+    std::size_t size() const { return unconstrained_.size() + constrained_.size(); }
+    std::uint64_t totalQuantity() const { return totalQuantity_; }
+
+    /**
+     * Earliest unconstrained order at this price
+     * @return Iterator to the order, or std::nullopt if only constrained orders rest here
+     */
+    std::optional<OrderPointers::iterator> frontUnconstrained();
+
+    /**
+     * Total remaining quantity of unconstrained orders (the depth an auction or pro-rata pass can allocate)
+     */
+    std::uint64_t unconstrainedQuantity() const { return unconstrainedQuantity_; }
+
+    /**
+     * Unconstrained orders in time priority, for allocation policies that spread a fill across the queue
+     */
+    OrderPointers& unconstrainedOrders() { return unconstrained_; }
+
+    private:
+    static constexpr std::uint32_t NO_SLOT = UINT32_MAX;
+    static constexpr std::uint32_t MIN_INDEX_CAPACITY = 16;
+
+    void buildIndex();
+    void setSlot(std::uint32_t slot, std::uint32_t threshold, std::uint32_t remaining);
+    std::uint32_t findSlot(std::uint32_t node, std::uint32_t counterRemaining, std::uint32_t counterThreshold) const;
+
+    OrderPointers unconstrained_;                          // FIFO queue of unconstrained orders
+    OrderPointers constrained_;                            // FIFO queue of AON/minimum-quantity orders
+    std::uint64_t totalQuantity_{0};                       // Remaining quantity of every order here
+    std::uint64_t unconstrainedQuantity_{0};               // Remaining quantity of unconstrained orders
+
+    // Match index (empty until first needed); slots are assigned in arrival order and
+    // renumbered when they run out, leaves live at [indexCapacity_, 2 * indexCapacity_)
+    std::vector<OrderPointers::iterator> slotOrders_;      // Slot -> order (live slots only)
+    std::vector<std::uint32_t> minThreshold_;              // Node -> smallest threshold below (UINT32_MAX if none)
+    std::vector<std::uint32_t> maxRemaining_;              // Node -> largest remaining quantity below (0 if none)
+    std::uint32_t indexCapacity_{0};                       // Leaf count (0 = index not built)
+    std::uint32_t nextSlot_{0};                            // Next unused slot
+};
+
+/**
+ * Per-level allocation policies for BasicOrderBook
+ * allocate() receives the earliest eligible order at the chosen price and an executor
+ * execute(location, quantity) that trades quantity against one resting order and returns
+ * false once the incoming order is filled or cancelled. The level is never erased while
+ * allocate() runs, and iterators to orders other than the one just executed stay valid.
+ */
+
+/**
+ * Strict price-time priority: the earliest eligible order takes as much as it can
+ */
+struct FifoAllocation
+{
+    template<typename Execute>
+    static void allocate(PriceLevel&, OrderPointers::iterator first, const Order& incoming, Execute& execute)
+    {
+        execute(first, std::min(incoming.getRemainingQuantity().get(), (*first)->getRemainingQuantity().get()));
+    }
+};
+
+/**
+ * Pro-rata: the incoming quantity is split across the level in proportion to resting size
+ * Shares are floor(incoming * size / level aggregate); the rounding remainder goes one lot at a
+ * time to the earliest orders with room left. Two passes over the queue, nothing allocated.
+ * Constrained orders (on either side) cannot take arbitrary shares and are filled FIFO instead.
+ */
+struct ProRataAllocation
+{
+    template<typename Execute>
+    static void allocate(PriceLevel& level, OrderPointers::iterator first, const Order& incoming, Execute& execute)
+    {
+        if ((*first)->getExecutionThreshold() != 0 || incoming.getExecutionThreshold() != 0) {
+            FifoAllocation::allocate(level, first, incoming, execute);
+            return;
+        }
+        allocateProRata(level, incoming.getRemainingQuantity().get(), execute);
+    }
+
+    template<typename Execute>
+    static void allocateProRata(PriceLevel& level, std::uint32_t quantity, Execute& execute)
+    {
+        std::uint64_t aggregate = level.unconstrainedQuantity();
+        if (aggregate == 0 || quantity == 0) {
+            return;
+        }
+        std::uint64_t allocatable = std::min<std::uint64_t>(quantity, aggregate);
+
+        // First pass: the floor shares, to learn how many lots rounding leaves over
+        OrderPointers& queue = level.unconstrainedOrders();
+        std::uint64_t allocated = 0;
+        for (const OrderPointer& resting : queue) {
+            allocated += allocatable * resting->getRemainingQuantity().get() / aggregate;
+        }
+        std::uint64_t leftover = allocatable - allocated;
+
+        // Second pass: execute each share, topped up by one lot while leftovers remain. Sizes are
+        // read before an order executes, so they match the first pass.
+        for (auto it = queue.begin(); it != queue.end();) {
+            auto next = std::next(it);  // Executing may drop the order from the queue
+            std::uint32_t size = (*it)->getRemainingQuantity().get();
+            auto share = static_cast<std::uint32_t>(allocatable * size / aggregate);
+            if (leftover != 0 && share < size) {
+                ++share;
+                --leftover;
+            }
+            if (share != 0 && !execute(it, share)) {
+                return;
+            }
+            it = next;
+        }
+    }
+};
+
+/**
+ * FIFO with top order: the earliest order at the price is filled first, then whatever the
+ * incoming order has left is shared pro-rata across the rest of the level
+ */
+struct FifoTopOrderAllocation
+{
+    template<typename Execute>
+    static void allocate(PriceLevel& level, OrderPointers::iterator first, const Order& incoming, Execute& execute)
+    {
+        bool constrained = (*first)->getExecutionThreshold() != 0 || incoming.getExecutionThreshold() != 0;
+        if (!execute(first, std::min(incoming.getRemainingQuantity().get(), (*first)->getRemainingQuantity().get())) ||
+            constrained) {
+            return;
+        }
+        ProRataAllocation::allocateProRata(level, incoming.getRemainingQuantity().get(), execute);
+    }
+};
+
 /**
  * Order modification request containing new order parameters
  * Used to replace existing orders while preserving original order type
@@ -132,10 +530,10 @@ class OrderModifier
 
     /**
      * Convert modification request to new Order instance
-     * @param type Order type from existing order (preserves original type)
+     * @param existing Order being replaced (its type, fill constraint, peg, owner and trailing offset are preserved)
      * @return New order with modified parameters
      */
-    OrderPointer toOrderPointer(OrderType type) const;
+    OrderPointer toOrderPointer(const Order& existing) const;
 
     private:
     OrderId id_;        // Order to modify
@@ -162,42 +560,206 @@ struct TradeInfo
 class Trade
 {
     public:
-    Trade(const TradeInfo& bid, const TradeInfo& ask):
+    Trade(const TradeInfo& bid, const TradeInfo& ask, Price price, std::optional<OrderSide> aggressor = std::nullopt):
     bid_{bid},
-    ask_{ask}
+    ask_{ask},
+    price_{price},
+    aggressor_{aggressor}
     {}
 
     const TradeInfo& getBid() const { return bid_; }
     const TradeInfo& getAsk() const { return ask_; }
+    Price getPrice() const { return price_; }
+    std::optional<OrderSide> getAggressor() const { return aggressor_; }
 
     private:
     TradeInfo bid_;  // Buyer side trade details
     TradeInfo ask_;  // Seller side trade details
+    Price price_;    // Execution price (resting order's price, or the auction price)
+    std::optional<OrderSide> aggressor_; // Side of the incoming order (none for auction uncross trades)
 };
 
 using Trades = std::vector<Trade>;
 
 /**
- * Central limit order book with price-time priority matching
- * Maintains separate bid/ask price levels with FIFO ordering within levels
+ * Trailing stops for one side, parked outside the book until they trigger
+ * Stops are grouped by water mark (the best last-trade price since they were placed) and keyed
+ * by offset inside a group, so a group's triggers all move with its single mark. When the price
+ * moves through lower marks those groups merge (smaller into larger, nodes spliced not copied),
+ * and a trigger index keyed by each group's nearest trigger means a trade only touches the stops
+ * that actually fire. Prices are oriented (negated for buys) so both sides share one algorithm.
  */
-class OrderBook
+class TrailingStops
 {
+    public:
+    explicit TrailingStops(OrderSide side):
+    side_{side}
+    {}
+
+    /**
+     * Park a trailing stop
+     * @param order Order with a trailing offset set
+     * @param lastTradePrice Initial water mark; without one the first trade sets it
+     */
+    void add(const OrderPointer& order, std::optional<Price> lastTradePrice);
+
+    /**
+     * Feed one trade price: ratchet water marks, then collect the stops it triggers
+     * @param price Execution price
+     * @param triggered Receives triggered orders in trigger order
+     */
+    void onTrade(Price price, std::vector<OrderPointer>& triggered);
+
+    /**
+     * Cancel a parked stop, removing it from its group (and the group once it is empty)
+     * @return true if the stop was live
+     */
+    bool cancel(OrderId orderId);
+    bool contains(OrderId orderId) const { return live_.find(orderId) != live_.end(); }
+    std::size_t size() const { return live_.size(); }
+
+    /**
+     * Look up a parked stop
+     * @return The stop, or nullptr if it is not parked here
+     */
+    OrderPointer find(OrderId orderId) const
+    {
+        auto it = live_.find(orderId);
+        return it == live_.end() ? nullptr : it->second.order_;
+    }
+
     private:
+    using Offsets = std::multimap<std::int64_t, OrderPointer>;           // Offset -> stop, nearest trigger first
+    using TriggerIndex = std::multimap<std::int64_t, std::int64_t, std::greater<std::int64_t>>; // Trigger -> mark
+
     /**
-     * Internal order tracking structure
-     * Links orders to their position in price level queues
+     * Stops sharing one water mark
+     * A group absorbed by a ratchet keeps a link to the group that took its nodes, so stops
+     * placed in it can still find the container they now live in.
      */
-    struct OrderEntry
+    struct Group
     {
-        OrderPointer order_{nullptr};        // Shared pointer to order
-        OrderPointers::iterator location;    // Iterator to order's position in price level
+        std::int64_t mark_;                 // Key in groups_
+        Offsets stops_;                     // Stops sharing this water mark
+        TriggerIndex::iterator trigger_;    // This group's entry in triggers_
+        std::shared_ptr<Group> mergedInto_; // Set once a ratchet moved the stops elsewhere
+    };
+    using GroupPointer = std::shared_ptr<Group>;
+
+    /**
+     * Where a parked stop sits, so a cancel erases it without a search
+     */
+    struct LiveStop
+    {
+        OrderPointer order_;
+        GroupPointer group_;                // Group it was placed in (follow mergedInto_)
+        Offsets::iterator position_;        // Node in the current group's stops_
+    };
+
+    std::int64_t orient(Price price) const { return side_ == OrderSide::SELL ? price.get() : -std::int64_t{price.get()}; }
+    GroupPointer& groupAt(std::int64_t mark);
+    void reindexGroup(Group& group);
+
+    OrderSide side_;
+    std::map<std::int64_t, GroupPointer> groups_;          // Oriented water mark -> group
+    TriggerIndex triggers_;                                 // Nearest oriented trigger per group
+    std::unordered_map<OrderId, LiveStop> live_;            // Parked, uncancelled stops
+};
+
+/**
+ * Central limit order book with price priority matching
+ * Maintains separate bid/ask price levels; how an incoming order is shared among the orders
+ * at one price is decided at compile time by AllocationPolicy (FIFO by default)
+ */
+template<typename AllocationPolicy = FifoAllocation>
+class BasicOrderBook
+{
+    private:
+    static constexpr std::size_t PEG_REFERENCE_COUNT = 3; // PRIMARY, MARKET, MID
+
+    // Pegged orders grouped by offset, best offset first; one set per reference so a
+    // touch move reprices every peg at once without touching any of them
+    using BidPegQueue = std::map<std::int32_t, PriceLevel, std::greater<std::int32_t>>;
+    using AskPegQueue = std::map<std::int32_t, PriceLevel, std::less<std::int32_t>>;
+
+    /**
+     * Effective peg prices of one side against the current touch
+     * A peg never rests at or through the opposite touch: buy pegs are capped one tick below the
+     * best ask, and sell pegs are floored one tick above the best bid, pegged bids included, so
+     * two pegs cannot lock or cross each other either. Buckets clamped onto the same price keep
+     * their offset order.
+     */
+    struct PegPricing
+    {
+        OrderSide side_;
+        std::array<std::optional<std::int32_t>, PEG_REFERENCE_COUNT> references_;  // Per PegType - 1
+        std::optional<std::int32_t> limit_;  // Most aggressive price a peg may take, if the opposite side has one
+
+        /**
+         * Price of one peg bucket
+         * @param reference PegType - 1
+         * @param offset Bucket offset
+         * @return Effective price, or std::nullopt if the reference is missing or the price is not positive
+         */
+        std::optional<Price> price(std::size_t reference, std::int32_t offset) const
+        {
+            if (!references_[reference]) {
+                return std::nullopt;
+            }
+            std::int32_t price = *references_[reference] + offset;
+            if (limit_) {
+                price = (side_ == OrderSide::BUY) ? std::min(price, *limit_) : std::max(price, *limit_);
+            }
+            return price > 0 ? std::optional<Price>(Price(price)) : std::nullopt;
+        }
+
+        bool operator==(const PegPricing&) const = default;
     };
 
     // Core data structures for order book
-    std::map<Price, OrderPointers, std::greater<Price>> bids_;  // Bids: highest price first
-    std::map<Price, OrderPointers, std::less<Price>> asks_;     // Asks: lowest price first  
-    std::unordered_map<OrderId, OrderEntry> orders_;           // Fast order ID lookup
+    std::map<Price, PriceLevel, std::greater<Price>> bids_;    // Bids: highest price first
+    std::map<Price, PriceLevel, std::less<Price>> asks_;       // Asks: lowest price first  
+    std::array<BidPegQueue, PEG_REFERENCE_COUNT> bidPegs_;     // Pegged bids by reference
+    std::array<AskPegQueue, PEG_REFERENCE_COUNT> askPegs_;     // Pegged asks by reference
+    std::unordered_map<OrderId, OrderPointer> orders_;         // Fast order ID lookup (resting orders know their level)
+    std::uint64_t nextSequence_{0};                            // Arrival counter for time priority
+    SelfTradePrevention selfTradePrevention_{SelfTradePrevention::NONE}; // Same-owner handling
+    bool auctionActive_{false};                                // Call phase: orders rest without matching
+    std::optional<Price> lastTradePrice_;                      // Reference for trailing stops
+    TrailingStops buyStops_{OrderSide::BUY};                   // Trailing buy stops (trail the low)
+    TrailingStops sellStops_{OrderSide::SELL};                 // Trailing sell stops (trail the high)
+    std::uint32_t lastTradeQuantity_{0};                       // Size of the most recent execution
+    std::uint64_t topSequence_{0};                             // State changes published so far
+    bool topOfBookEnabled_{false};                             // Top of book is published (a reader asked for it)
+    bool depthEnabled_{false};                                 // Depth is tracked and published (a reader asked for it)
+    SeqLock<TopOfBook> topOfBook_;                             // Published for readers on other threads
+    DepthBuffers depth_;                                       // Published depth for readers on other threads
+    bool depthPending_{false};                                 // A depth publish was deferred
+    std::vector<std::pair<std::size_t, std::int32_t>> dirtyBidPegs_; // (reference, offset) of peg buckets changed
+    std::vector<std::pair<std::size_t, std::int32_t>> dirtyAskPegs_; // since the last depth publish
+    std::optional<PegPricing> bidPegsInDepth_;                 // Pricing of the pegs folded into the last depth
+    std::optional<PegPricing> askPegsInDepth_;                 // publish (none if the side held no pegs)
+    std::vector<OrderId>* removedOrders_{nullptr};             // Receives ids leaving the book, if tracked
+
+    /**
+     * Outcome of an auction equilibrium calculation
+     */
+    struct AuctionEquilibrium
+    {
+        Price price_;           // Single uncross price
+        std::uint64_t volume_;  // Executable volume at that price
+        std::int64_t surplus_;  // Bid depth minus ask depth at that price
+    };
+
+    /**
+     * Find the price maximising executable volume over cumulative bid/ask depth
+     * Ties are broken by smallest surplus, then market pressure (highest price on
+     * buy surplus, lowest on sell surplus), then proximity to the reference price.
+     * One ascending pass over the merged price levels; constrained and pegged orders are excluded.
+     * @param referencePrice Tie-break reference (e.g. last traded or previous close)
+     * @return Equilibrium, or std::nullopt if the book does not cross
+     */
+    std::optional<AuctionEquilibrium> computeAuctionEquilibrium(std::optional<Price> referencePrice) const;
 
     /**
      * Check if an order can potentially match against opposite side
@@ -208,27 +770,173 @@ class OrderBook
     bool canMatch(OrderSide side, Price price) const;
 
     /**
-     * Execute all possible trades using price-time priority matching
-     * Continues until no more matches possible or FOK orders need cancellation
+     * Current reference price for pegs on one side, derived from limit orders only
+     * @param side Side of the pegged orders
+     * @param type Reference tracked
+     * @return Reference price, or std::nullopt if the touch needed is missing
+     */
+    std::optional<std::int32_t> getPegReference(OrderSide side, PegType type) const;
+
+    /**
+     * Capture the references and clamp that price one side's pegs right now
+     * @param side Side of the pegged orders
+     */
+    PegPricing getPegPricing(OrderSide side) const;
+
+    /**
+     * Best effective price among pegged orders on one side
+     * @param side Side of the pegged orders
+     * @return Best peg price, or std::nullopt if no peg is currently priced
+     */
+    std::optional<Price> getBestPegPrice(OrderSide side) const;
+
+    /**
+     * Match an incoming order against the opposite side using price-time priority
+     * Walks crossing limit levels and peg buckets best-first and, at each price, hands the earliest
+     * resting order whose fill constraint the incoming order satisfies (and vice versa) to
+     * AllocationPolicy, which decides how the incoming quantity is shared across that price
+     * @param order Incoming order (not yet resting in the book)
+     * @param incomingCancelled Set when self-trade prevention cancels the incoming order's remainder
      * @return Vector of executed trades
      */
-    Trades matchOrders();
+    Trades matchOrders(const OrderPointer& order, bool& incomingCancelled);
+
+    /**
+     * Validate, match and rest a single order (no trailing stop processing)
+     * @param order Order to submit
+     * @return Vector of trades generated from matching
+     */
+    Trades submitOrder(const OrderPointer& order);
+
+    /**
+     * Feed new trades to the trailing stops and route every stop they trigger through addOrder
+     * Trades produced by triggered stops are appended and fed back in turn
+     * @param trades Trades of the current call; extended in place
+     * @param firstUnprocessed Index of the first trade not yet seen by the stops
+     */
+    void processTrailingStops(Trades& trades, std::size_t firstUnprocessed = 0);
+
+    /**
+     * Remove a resting order or parked trailing stop without publishing
+     * @param orderId Unique identifier of order to remove
+     * @return true if anything was removed
+     */
+    bool removeOrder(OrderId orderId);
+
+    /**
+     * Report an order leaving the book to the tracking vector, if any
+     */
+    void noteRemoved(OrderId orderId)
+    {
+        if (removedOrders_ != nullptr) {
+            removedOrders_->push_back(orderId);
+        }
+    }
+
+    /**
+     * Take a resting order out of its level (dropping the level once empty) and the lookup table
+     * @param order Resting order; reached through its stored level position, not looked up
+     */
+    void removeResting(Order& order);
+
+    /**
+     * Cancel the siblings an OCO execution fired, reaching each through the ring and its stored
+     * level position; only a parked trailing stop needs its side's stop lookup
+     * @param siblings Orders marked cancelled by fireOco (cleared)
+     * @param beforeEmpty Called as beforeEmpty(level) just before a cancel empties a level, so a
+     *                    walk holding a cursor on it can step past instead of restarting
+     */
+    template<typename BeforeEmpty>
+    void cancelOcoSiblings(std::vector<Order*>& siblings, BeforeEmpty beforeEmpty);
+
+    /**
+     * Visit one side's aggregated levels best-first, pegs folded in at their current effective price
+     * Limit levels and each reference's peg buckets are already sorted, so they are merged in place
+     * @param emit Called as emit(price, totalQuantity) for each level
+     */
+    template<typename SideMap, typename PegQueues, typename Emit>
+    void forEachLevel(const SideMap& sideMap, const PegQueues& pegQueues, OrderSide side, Emit emit) const;
+
+    /**
+     * Note a limit level whose quantity changed, for the incremental depth refresh
+     */
+    void markDepthDirty(OrderSide side, Price price)
+    {
+        if (depthEnabled_) {
+            depth_.markDirty(side == OrderSide::BUY, price.get());
+        }
+    }
+
+    /**
+     * Note a peg bucket whose quantity changed; priced when depth is next published
+     */
+    void markPegDirty(const Order& order)
+    {
+        markPegDirty(order.getOrderSide(), static_cast<std::size_t>(order.getPegType()) - 1, order.getPegOffset());
+    }
+
+    void markPegDirty(OrderSide side, std::size_t reference, std::int32_t offset)
+    {
+        if (depthEnabled_) {
+            (side == OrderSide::BUY ? dirtyBidPegs_ : dirtyAskPegs_).emplace_back(reference, offset);
+        }
+    }
+
+    /**
+     * Quantity pegged at one effective price on a side
+     * @param pegQueues Peg buckets of the side
+     * @param pricing Current pricing of the side
+     * @param price Effective price
+     */
+    template<typename PegQueues>
+    std::uint64_t pegQuantityAt(const PegQueues& pegQueues, const PegPricing& pricing, Price price) const;
+
+    /**
+     * Publish whichever of top of book and depth readers asked for
+     * Called once at the end of every public operation that can change the book, so readers
+     * never see the intermediate states of a match, modify or uncross. A book nobody reads
+     * publishes nothing.
+     */
+    void publishMarketData();
+
+    /**
+     * Recompute the touch and publish it through topOfBook_
+     */
+    void publishTopOfBook();
+
+    /**
+     * Bring a back depth buffer up to date and flip it to the front
+     * Prices changed since that buffer was written are refreshed, pegs at their effective price;
+     * a side is rebuilt only when a touch move reprices its pegs.
+     */
+    void publishDepth();
 
     public:
 
     /**
      * Add new order to book and attempt immediate matching
+     * Trailing stops are parked until triggered; stops triggered by the resulting trades
+     * are submitted within the same call and their trades are included
      * @param order Shared pointer to order to add
      * @return Vector of trades generated from matching
      */
     Trades addOrder(OrderPointer order);
 
     /**
-     * Remove order from book by ID
+     * Remove order (or parked trailing stop) by ID
      * @param orderId Unique identifier of order to cancel
      */
     void cancelOrder(OrderId orderId);
 
+    /**
+     * Shrink a resting order (or parked trailing stop) in place without trading
+     * The order keeps its time priority; reducing by its whole remainder cancels it
+     * @param orderId Order to reduce
+     * @param quantity Amount to remove
+     * @return false if no such order rests or is parked
+     */
+    bool reduceOrder(OrderId orderId, Quantity quantity);
+
     /**
      * Modify existing order by canceling and re-adding with new parameters
      * @param order OrderModifier containing new order parameters
@@ -242,16 +950,130 @@ class OrderBook
      */
     std::size_t getSize() const {return orders_.size();}
 
+    /**
+     * Select how same-owner crosses are handled for subsequent incoming orders
+     * @param mode Self-trade prevention mode (NONE allows self-trades)
+     */
+    void setSelfTradePrevention(SelfTradePrevention mode) { selfTradePrevention_ = mode; }
+    SelfTradePrevention getSelfTradePrevention() const { return selfTradePrevention_; }
+
+    /**
+     * Report the id of every order that leaves the book or the parked stops, whether it filled,
+     * was cancelled (directly, by self-trade prevention or by an OCO sibling) or was a trailing
+     * stop that triggered. An id may be reported and then rest again (a modify, or a triggered
+     * stop that rests), so callers check orderExists before acting on it.
+     * @param removed Vector the ids are appended to, or nullptr to stop reporting
+     */
+    void trackRemovedOrders(std::vector<OrderId>* removed) { removedOrders_ = removed; }
+
+    /**
+     * Enter the call phase: incoming orders accumulate without matching
+     * FOK orders are rejected while the auction is active
+     */
+    void startAuction() { auctionActive_ = true; }
+    bool isAuctionActive() const { return auctionActive_; }
+
+    /**
+     * End the call phase and execute all crossing volume at the equilibrium price
+     * Orders are allocated in price-time priority; constrained and pegged orders stay in the book
+     * @param referencePrice Final tie-break for the equilibrium price
+     * @return Vector of trades, all at the single uncross price
+     */
+    Trades uncrossAuction(std::optional<Price> referencePrice = std::nullopt);
+
     /**
      * Check if an order with given ID exists in the book
      * @param orderId Unique identifier of order to check
      * @return true if order exists, false otherwise
      */
-    bool orderExists(OrderId orderId) const { return orders_.find(orderId) != orders_.end(); }
+    bool orderExists(OrderId orderId) const
+    {
+        return orders_.find(orderId) != orders_.end() || buyStops_.contains(orderId) || sellStops_.contains(orderId);
+    }
+
+    /**
+     * Look up a resting order
+     * @param orderId Unique identifier of order to find
+     * @return The order, or nullptr if it is not resting in the book (parked stops are not returned)
+     */
+    OrderPointer findOrder(OrderId orderId) const
+    {
+        auto it = orders_.find(orderId);
+        return it == orders_.end() ? nullptr : it->second;
+    }
+
+    /**
+     * Price of the most recent execution, if any
+     */
+    std::optional<Price> getLastTradePrice() const { return lastTradePrice_; }
+
+    /**
+     * Start publishing top of book for readers on other threads (off by default)
+     * Publishes the current touch at once, then after every operation. Call before starting readers.
+     */
+    void enableTopOfBook()
+    {
+        topOfBookEnabled_ = true;
+        publishMarketData();
+    }
+
+    /**
+     * Start tracking and publishing full depth for readers on other threads (off by default)
+     * Publishes the current depth at once, then after every operation. Call before starting readers.
+     */
+    void enableDepth()
+    {
+        depthEnabled_ = true;
+        depth_.markRebuild(true);
+        depth_.markRebuild(false);
+        publishMarketData();
+    }
+
+    /**
+     * Consistent snapshot of the touch; safe to call from any thread while the book is matching
+     * Only published once enableTopOfBook() has been called
+     * Retries only while a publish is in progress, and never blocks the matching thread
+     * @return Most recently published top of book
+     */
+    TopOfBook getTopOfBook() const { return topOfBook_.load(); }
+
+    /**
+     * Single wait-free snapshot attempt; safe to call from any thread
+     * @param top Receives the snapshot on success
+     * @return false if it overlapped a publish (retry later)
+     */
+    bool tryGetTopOfBook(TopOfBook& top) const { return topOfBook_.tryLoad(top); }
+
+    /**
+     * Consistent full-depth snapshot; safe to call from any thread while the book is matching
+     * Copies the front depth buffer without locks and without allocating once the snapshot's
+     * vectors have grown to the book's depth. The matching thread is never blocked.
+     * Only published once enableDepth() has been called.
+     * @param snapshot Receives both sides (pegs at their effective price) and the state sequence
+     */
+    void getDepthSnapshot(DepthSnapshot& snapshot) const { depth_.read(snapshot); }
+
+    /**
+     * Publish depth if a refresh was deferred because readers held every back buffer
+     * Call from the matching thread when it goes idle, so readers catch up without a new command
+     * @return true if the published depth is current
+     */
+    bool flushDepth()
+    {
+        if (depthPending_) {
+            publishDepth();
+        }
+        return !depthPending_;
+    }
 
     /**
      * Generate aggregated order book snapshot for market data
+     * Pegged orders are included at their effective price at the time of the call
      * @return OrderBookBAA containing bid/ask level summaries
      */
     OrderBookBAA getOrderBookLevelInfos() const;
 };
+
+using OrderBook = BasicOrderBook<FifoAllocation>;                  // Strict price-time priority
+using ProRataOrderBook = BasicOrderBook<ProRataAllocation>;        // Pro-rata within each price
+using TopOrderOrderBook = BasicOrderBook<FifoTopOrderAllocation>;  // Top order first, then pro-rata
@@ -0,0 +1,25 @@
+/**
+ * Paced Replay Module
+ * Releases events at their recorded inter-arrival times to reproduce real bursts
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "trade_tape.h"
+#include <string>
+
+/**
+ * Replay a CSV or binary event file at recorded pace and report latency percentiles
+ * Each event is released when its timestamp offset (divided by speed) has elapsed since the
+ * first event, using a busy-wait on the TSC. Latency is measured from the scheduled release
+ * to the completion of the engine call, so queueing behind a slow event counts against the
+ * events that waited. Timestamps that go backwards are released immediately. The engine log
+ * is muted for the duration.
+ * @param filename Path to input file (CSV timestamps are the optional 7th column, in ns)
+ * @param orderBook Order book instance to process orders against
+ * @param speed Replay speed multiplier (2.0 halves every gap; must be positive)
+ * @param tape Optional tape receiving every trade
+ * @return false if the file could not be read
+ */
+bool processPacedFile(const std::string& filename, OrderBook& orderBook, double speed, TradeTape* tape = nullptr);
@@ -0,0 +1,33 @@
+/**
+ * Pipelined Replay Module
+ * Decodes input on a parser thread and matches on the calling thread, connected by an SPSC ring
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "order_command.h"
+#include "trade_tape.h"
+#include <string>
+
+/**
+ * Decoded command in flight between the parser and matching threads
+ */
+struct ReplayEvent
+{
+    OrderCommand command_;     // Decoded operation
+    std::uint64_t sourceOffset_; // Byte offset of the line or record it came from
+};
+
+constexpr std::size_t PIPELINE_RING_CAPACITY = 1 << 16; // Events buffered between the threads
+constexpr std::size_t PIPELINE_BATCH_SIZE = 256;        // Events moved per ring operation
+
+/**
+ * Replay a CSV or binary event file with parsing and matching on separate threads
+ * The format is detected from the binary event header. The calling thread does the
+ * matching, so the order book never leaves it.
+ * @param filename Path to input file
+ * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade (committed after each ring batch)
+ */
+void processPipelinedFile(const std::string& filename, OrderBook& orderBook, TradeTape* tape = nullptr);
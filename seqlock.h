@@ -0,0 +1,95 @@
+/**
+ * Sequence Lock Module
+ * Single-writer publication of a small record to any number of lock-free readers
+ */
+
+#pragma once
+
+#include <atomic>       // Sequence counter and payload words
+#include <cstdint>
+#include <cstring>      // Record <-> word copies
+#include <type_traits>
+#include "spsc_ring.h"  // CACHE_LINE_SIZE, cpuRelax
+
+/**
+ * Seqlock holding one trivially copyable record
+ * The writer bumps the sequence to odd, stores the payload and bumps it back to even; a reader
+ * copies the payload between two reads of the sequence and keeps the copy only if both reads
+ * match and are even. The writer never waits for readers and readers never write, so readers
+ * cost the writer nothing but cache traffic on the record's lines.
+ * The payload is held in relaxed atomic words, so a torn read is detected rather than undefined.
+ * @tparam T Trivially copyable record type
+ */
+template<typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock records must be trivially copyable");
+
+    public:
+    SeqLock() : SeqLock(T{}) {}
+    explicit SeqLock(const T& initial) { store(initial); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * Publish a new record (single writer only)
+     * @param value Record to publish
+     */
+    void store(const T& value) {
+        std::uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // Odd sequence is visible before any payload word
+        for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * Take one snapshot attempt; wait-free
+     * @param value Receives the record when the attempt succeeds
+     * @return false if a store was in progress or completed during the copy
+     */
+    bool tryLoad(T& value) const {
+        std::uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        std::uint64_t words[WORD_COUNT];
+        for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire); // Payload reads complete before the recheck
+        if (sequence_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * Take a consistent snapshot, retrying while the writer is mid-store
+     * @return Most recently published record
+     */
+    T load() const {
+        T value;
+        while (!tryLoad(value)) {
+            cpuRelax();
+        }
+        return value;
+    }
+
+    /**
+     * Number of stores so far
+     */
+    std::uint64_t getVersion() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+    private:
+    static constexpr std::size_t WORD_COUNT = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> sequence_{0};
+    std::atomic<std::uint64_t> words_[WORD_COUNT];
+};
@@ -0,0 +1,593 @@
+/**
+ * Sharded Matching Implementation
+ * Ingress routing on the calling thread, one pinned thread per shard, and a sequencing merger
+ */
+
+#include "sharded_matching.h"
+#include "console_mute.h"   // Engine log suppression across workers
+#include "csv_processor.h"  // CsvCommandReader
+#include "mapped_file.h"    // Zero-copy input
+#include "spsc_ring.h"      // Per-worker inbound/outbound queues
+#include <pthread.h>        // pthread_setaffinity_np
+#include <sched.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>            // Stable symbol name storage
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t SHARD_OUTPUT_FLUSH_BYTES = 1 << 20; // Merged output written in chunks of this size
+
+/**
+ * One matching thread with its queues and the books it owns
+ */
+struct ShardWorker
+{
+    ShardWorker() : inbound_(SHARD_RING_CAPACITY), outbound_(SHARD_RING_CAPACITY) {}
+
+    SpscRing<ShardEvent> inbound_;    // Ingress -> worker
+    SpscRing<ShardResult> outbound_;  // Worker -> merger
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> inputClosed_{false}; // No more events will arrive
+    std::vector<std::unique_ptr<OrderBook>> books_; // Indexed by SymbolId; set only for owned symbols
+    int cpu_ = -1;                    // CPU the thread is pinned to (-1 if pinning failed)
+    std::uint64_t events_ = 0;        // Worker-private counters, read after join
+    std::uint64_t trades_ = 0;
+    std::uint64_t rejected_ = 0;
+    std::uint64_t migratedIn_ = 0;
+    std::uint64_t migratedOut_ = 0;
+    std::uint64_t busyNanos_ = 0;     // Time spent on popped batches (matching and pushing results)
+    std::size_t symbols_ = 0;         // Books currently owned
+};
+
+/**
+ * Spin until every item has been pushed
+ */
+template<typename T>
+void pushAll(SpscRing<T>& ring, const T* items, std::size_t count) {
+    SpinWait wait;
+    while (count != 0) {
+        std::size_t pushed = ring.pushBatch(items, count);
+        items += pushed;
+        count -= pushed;
+        if (pushed == 0) {
+            wait.wait();
+        } else {
+            wait.reset();
+        }
+    }
+}
+
+/**
+ * CPUs this process may run on
+ */
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+
+bool pinThread(std::thread& thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return ::pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+}
+
+/**
+ * Apply one event to the worker's book for its symbol and describe the outcome
+ */
+void matchEvent(ShardWorker& worker, const ShardEvent& event, std::vector<ShardResult>& results) {
+    if (event.symbol_ >= worker.books_.size()) {
+        worker.books_.resize(event.symbol_ + 1);
+    }
+    std::unique_ptr<OrderBook>& book = worker.books_[event.symbol_];
+    if (!book) {
+        book = std::make_unique<OrderBook>();
+        worker.symbols_++;
+    }
+
+    const OrderCommand& command = event.command_;
+    ShardResult result{};
+    result.sequence_ = event.sequence_;
+    result.name_ = event.name_;
+    result.action_ = command.action_;
+    try {
+        Trades trades = applyOrderCommand(*book, command);
+        result.kind_ = ShardResultKind::TRADE;
+        for (const Trade& trade : trades) {
+            result.orderId_ = trade.getBid().orderId_;
+            result.counterId_ = trade.getAsk().orderId_;
+            result.price_ = trade.getPrice().get();
+            result.quantity_ = trade.getBid().quantity_.get();
+            result.aggressor_ = trade.getAggressor();
+            results.push_back(result);
+        }
+        worker.trades_ += trades.size();
+        result.kind_ = ShardResultKind::ACK;
+        result.orderId_ = command.orderId_;
+        result.counterId_ = 0;
+        result.price_ = 0;
+        result.quantity_ = 0;
+        result.resting_ = book->orderExists(command.orderId_);
+    } catch (const std::exception& e) {
+        worker.rejected_++;
+        result.kind_ = ShardResultKind::REJECT;
+        result.orderId_ = command.orderId_;
+        std::strncpy(result.reason_, e.what(), SHARD_REASON_BYTES - 1);
+    }
+    results.push_back(result);
+}
+
+/**
+ * Give up a symbol's book: every earlier command for it is already applied
+ */
+void releaseBook(ShardWorker& worker, const ShardEvent& event) {
+    OrderBook* book = nullptr;
+    if (event.symbol_ < worker.books_.size() && worker.books_[event.symbol_]) {
+        book = worker.books_[event.symbol_].release();
+        worker.symbols_--;
+    }
+    event.handoff_->book_.store(book, std::memory_order_relaxed);
+    event.handoff_->ready_.store(true, std::memory_order_release);
+    worker.migratedOut_++;
+}
+
+/**
+ * Take over a symbol's book once the old worker has released it
+ * Pending results are pushed first: the merger may need them before the old worker can progress.
+ */
+void adoptBook(ShardWorker& worker, const ShardEvent& event, std::vector<ShardResult>& results) {
+    pushAll(worker.outbound_, results.data(), results.size());
+    results.clear();
+
+    SpinWait wait;
+    while (!event.handoff_->ready_.load(std::memory_order_acquire)) {
+        wait.wait();
+    }
+    if (event.symbol_ >= worker.books_.size()) {
+        worker.books_.resize(event.symbol_ + 1);
+    }
+    OrderBook* book = event.handoff_->book_.load(std::memory_order_relaxed);
+    if (book) {
+        worker.books_[event.symbol_].reset(book);
+        worker.symbols_++;
+    }
+    worker.migratedIn_++;
+}
+
+void runWorker(ShardWorker& worker) {
+    std::unique_ptr<ShardEvent[]> events(new ShardEvent[SHARD_BATCH_SIZE]);
+    std::vector<ShardResult> results;
+    results.reserve(SHARD_BATCH_SIZE * 4);
+    SpinWait wait;
+
+    while (true) {
+        // Read the flag before popping so events pushed before it was set are never missed
+        bool closed = worker.inputClosed_.load(std::memory_order_acquire);
+        std::size_t count = worker.inbound_.popBatch(events.get(), SHARD_BATCH_SIZE);
+        if (count == 0) {
+            if (closed) {
+                break;
+            }
+            wait.wait();
+            continue;
+        }
+        wait.reset();
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            const ShardEvent& event = events[i];
+            switch (event.kind_) {
+                case ShardEventKind::COMMAND:
+                    matchEvent(worker, event, results);
+                    worker.events_++;
+                    break;
+                case ShardEventKind::MIGRATE_OUT:
+                    releaseBook(worker, event);
+                    break;
+                case ShardEventKind::MIGRATE_IN:
+                    adoptBook(worker, event, results);
+                    break;
+            }
+        }
+        pushAll(worker.outbound_, results.data(), results.size());
+        results.clear();
+        worker.busyNanos_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+const char* actionName(OrderAction action) {
+    switch (action) {
+        case OrderAction::CREATE: return "CREATE";
+        case OrderAction::MODIFY: return "MODIFY";
+        case OrderAction::CANCEL: return "CANCEL";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * Append one result as a CSV line
+ */
+void appendResult(std::string& output, const ShardResult& result) {
+    output += std::to_string(result.sequence_);
+    switch (result.kind_) {
+        case ShardResultKind::TRADE:
+            output += ",TRADE,";
+            output += *result.name_;
+            output += ',';
+            output += std::to_string(result.orderId_);
+            output += ',';
+            output += std::to_string(result.counterId_);
+            output += ',';
+            output += std::to_string(result.price_);
+            output += ',';
+            output += std::to_string(result.quantity_);
+            break;
+        case ShardResultKind::ACK:
+            output += ",ACK,";
+            output += *result.name_;
+            output += ',';
+            output += actionName(result.action_);
+            output += ',';
+            output += std::to_string(result.orderId_);
+            output += result.resting_ ? ",RESTING" : ",DONE";
+            break;
+        case ShardResultKind::REJECT:
+            output += ",REJECT,";
+            output += *result.name_;
+            output += ',';
+            output += actionName(result.action_);
+            output += ',';
+            output += std::to_string(result.orderId_);
+            output += ',';
+            output += result.reason_;
+            break;
+    }
+    output += '\n';
+}
+
+/**
+ * Counters gathered by the merger
+ */
+struct MergeStats
+{
+    std::uint64_t results_ = 0;
+    std::uint64_t trades_ = 0;
+    bool writeFailed_ = false;
+};
+
+/**
+ * Emit every worker's results in input sequence
+ * Each worker's results are already in sequence order, and each sequence lives on exactly one
+ * worker, so the merger only has to find the worker holding the next sequence.
+ */
+void runMerger(std::vector<std::unique_ptr<ShardWorker>>& workers, const std::atomic<bool>& ingressDone,
+               const std::atomic<std::uint64_t>& totalEvents, std::ofstream* output, TradeTape* tape,
+               MergeStats& stats) {
+    std::size_t count = workers.size();
+    std::vector<std::unique_ptr<ShardResult[]>> pending(count);
+    std::vector<std::size_t> pendingSize(count, 0);
+    std::vector<std::size_t> pendingIndex(count, 0);
+    for (auto& buffer : pending) {
+        buffer.reset(new ShardResult[SHARD_BATCH_SIZE]);
+    }
+
+    std::string text;
+    Trades trades; // Trades of the current sequence, recorded on the tape once it completes
+    std::uint64_t next = 1;
+    SpinWait wait;
+    while (true) {
+        if (ingressDone.load(std::memory_order_acquire) && next > totalEvents.load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        bool progressed = false;
+        for (std::size_t i = 0; i < count; ++i) {
+            while (true) {
+                if (pendingIndex[i] == pendingSize[i]) {
+                    pendingSize[i] = workers[i]->outbound_.popBatch(pending[i].get(), SHARD_BATCH_SIZE);
+                    pendingIndex[i] = 0;
+                    if (pendingSize[i] == 0) {
+                        break;
+                    }
+                }
+                const ShardResult& result = pending[i][pendingIndex[i]];
+                if (result.sequence_ != next) {
+                    break;
+                }
+                pendingIndex[i]++;
+                progressed = true;
+                stats.results_++;
+                if (result.kind_ == ShardResultKind::TRADE) {
+                    stats.trades_++;
+                    if (tape) {
+                        Price price(result.price_);
+                        Quantity quantity(result.quantity_);
+                        trades.emplace_back(TradeInfo{result.orderId_, price, quantity},
+                                            TradeInfo{result.counterId_, price, quantity}, price, result.aggressor_);
+                    }
+                } else {
+                    next++;
+                    if (tape && !trades.empty()) {
+                        tape->record(trades);
+                        tape->commit();
+                        trades.clear();
+                    }
+                }
+                if (output) {
+                    appendResult(text, result);
+                }
+            }
+        }
+
+        if (text.size() >= SHARD_OUTPUT_FLUSH_BYTES) {
+            output->write(text.data(), static_cast<std::streamsize>(text.size()));
+            text.clear();
+        }
+        if (progressed) {
+            wait.reset();
+        } else {
+            wait.wait();
+        }
+    }
+
+    if (output) {
+        output->write(text.data(), static_cast<std::streamsize>(text.size()));
+        output->flush();
+        stats.writeFailed_ = !*output;
+    }
+}
+
+/**
+ * Book move decided by a rebalance round
+ */
+struct ShardMigration
+{
+    SymbolId symbol_;
+    unsigned from_;
+    unsigned to_;
+};
+
+/**
+ * Move books from the busiest worker to the idlest until loads are within tolerance of the mean
+ * A worker's load is the sum of its symbols' rates. Each move takes the largest book that still
+ * narrows the gap between the two workers; a worker's hottest book never moves, so hot symbols
+ * keep their core and shed the cold ones around them instead.
+ * @param rates Decayed message rate per symbol
+ * @param shardOf Symbol to worker table, updated in place
+ * @param workerCount Number of workers
+ * @return Moves applied to the table, in order
+ */
+std::vector<ShardMigration> rebalanceShards(const std::vector<double>& rates, std::vector<unsigned>& shardOf,
+                                            unsigned workerCount) {
+    std::vector<ShardMigration> migrations;
+    std::vector<double> load(workerCount, 0.0);
+    std::vector<SymbolId> hottest(workerCount, NO_SYMBOL);
+    double total = 0.0;
+    for (SymbolId symbol = 0; symbol < shardOf.size(); ++symbol) {
+        unsigned shard = shardOf[symbol];
+        load[shard] += rates[symbol];
+        total += rates[symbol];
+        if (hottest[shard] == NO_SYMBOL || rates[symbol] > rates[hottest[shard]]) {
+            hottest[shard] = symbol;
+        }
+    }
+    double ceiling = total / workerCount * (1.0 + SHARD_IMBALANCE_TOLERANCE);
+
+    while (migrations.size() < SHARD_MAX_MIGRATIONS) {
+        unsigned hot = static_cast<unsigned>(std::max_element(load.begin(), load.end()) - load.begin());
+        unsigned cold = static_cast<unsigned>(std::min_element(load.begin(), load.end()) - load.begin());
+        if (load[hot] <= ceiling) {
+            break;
+        }
+        double limit = (load[hot] - load[cold]) / 2.0;
+        SymbolId pick = NO_SYMBOL;
+        for (SymbolId symbol = 0; symbol < shardOf.size(); ++symbol) {
+            double rate = rates[symbol];
+            if (shardOf[symbol] == hot && symbol != hottest[hot] && rate > 0.0 && rate < limit &&
+                (pick == NO_SYMBOL || rate > rates[pick])) {
+                pick = symbol;
+            }
+        }
+        if (pick == NO_SYMBOL) {
+            break;
+        }
+        shardOf[pick] = cold;
+        load[hot] -= rates[pick];
+        load[cold] += rates[pick];
+        migrations.push_back({pick, hot, cold});
+    }
+    return migrations;
+}
+
+} // namespace
+
+bool processShardedFile(const std::string& filename, unsigned workerCount, const std::string& outputPath,
+                        bool rebalance, TradeTape* tape) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return false;
+    }
+    std::unique_ptr<std::ofstream> output;
+    if (!outputPath.empty()) {
+        output = std::make_unique<std::ofstream>(outputPath, std::ios::binary | std::ios::trunc);
+        if (!output->is_open()) {
+            std::cerr << "Error: Cannot create file " << outputPath << std::endl;
+            return false;
+        }
+    }
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto mute = std::make_unique<ConsoleMute>(); // Released before the summary
+    auto start = std::chrono::steady_clock::now();
+
+    // Workers get their own CPUs; the first allowed CPU is left to ingress and the merger when possible
+    std::vector<std::unique_ptr<ShardWorker>> workers;
+    std::vector<std::thread> threads;
+    std::vector<int> cpus = allowedCpus();
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.push_back(std::make_unique<ShardWorker>());
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        ShardWorker& worker = *workers[i];
+        threads.emplace_back(runWorker, std::ref(worker));
+        if (!cpus.empty()) {
+            int cpu = cpus[(i + 1) % cpus.size()];
+            worker.cpu_ = pinThread(threads.back(), cpu) ? cpu : -1;
+        }
+    }
+
+    std::atomic<bool> ingressDone{false};
+    std::atomic<std::uint64_t> totalEvents{0};
+    MergeStats mergeStats;
+    std::thread merger(runMerger, std::ref(workers), std::cref(ingressDone), std::cref(totalEvents),
+                       output.get(), tape, std::ref(mergeStats));
+
+    // Ingress: parse, assign symbols to workers and batch events per worker
+    SymbolIndex symbolIds;
+    std::deque<std::string> symbolNames;  // Stable addresses handed to workers
+    std::vector<unsigned> shardOf;        // SymbolId -> worker
+    std::vector<std::vector<ShardEvent>> staged(workerCount);
+    for (auto& batch : staged) {
+        batch.reserve(SHARD_BATCH_SIZE);
+    }
+    auto flush = [&](unsigned shard) {
+        pushAll(workers[shard]->inbound_, staged[shard].data(), staged[shard].size());
+        staged[shard].clear();
+    };
+
+    // Load tracking for rebalancing: events per symbol this interval, folded into a decaying rate
+    std::vector<std::uint32_t> windowCounts;
+    std::vector<double> rates;
+    std::deque<ShardHandoff> handoffs;    // Outlive the workers that use them
+    std::uint64_t rounds = 0;
+
+    CsvCommandReader reader(file.data());
+    reader.setAcceptSymbols(true);
+    OrderCommand command;
+    std::uint64_t sequence = 0;
+    std::uint64_t missingSymbol = 0;
+    std::string lastSymbol;
+    SymbolId lastId = NO_SYMBOL;
+
+    while (reader.next(command)) {
+        std::string_view symbol = reader.getSymbol();
+        if (symbol.empty()) {
+            missingSymbol++;
+            std::cerr << "Error processing line " << reader.getLineNumber() << " (byte " << reader.getLineOffset()
+                      << "): Order " << command.orderId_ << " has no symbol" << std::endl;
+            continue;
+        }
+        if (lastId == NO_SYMBOL || symbol != lastSymbol) {
+            auto found = symbolIds.find(symbol);
+            if (found == symbolIds.end()) {
+                SymbolId id = static_cast<SymbolId>(symbolNames.size());
+                symbolNames.emplace_back(symbol);
+                found = symbolIds.emplace(symbolNames.back(), id).first;
+                shardOf.push_back(id % workerCount);
+                windowCounts.push_back(0);
+                rates.push_back(0.0);
+            }
+            lastId = found->second;
+            lastSymbol.assign(symbol);
+        }
+
+        unsigned shard = shardOf[lastId];
+        staged[shard].push_back({++sequence, lastId, &symbolNames[lastId], command});
+        if (staged[shard].size() == SHARD_BATCH_SIZE) {
+            flush(shard);
+        }
+        windowCounts[lastId]++;
+
+        if (rebalance && workerCount > 1 && sequence % SHARD_REBALANCE_INTERVAL == 0) {
+            for (SymbolId id = 0; id < rates.size(); ++id) {
+                rates[id] = rates[id] * 0.5 + windowCounts[id];
+                windowCounts[id] = 0;
+            }
+            rounds++;
+            // Quiesce and hand off: the old worker releases the book after the symbol's last queued
+            // command, and the new worker adopts it before the symbol's next one
+            for (const ShardMigration& move : rebalanceShards(rates, shardOf, workerCount)) {
+                ShardHandoff& handoff = handoffs.emplace_back();
+                const std::string* name = &symbolNames[move.symbol_];
+                staged[move.from_].push_back({0, move.symbol_, name, {}, ShardEventKind::MIGRATE_OUT, &handoff});
+                flush(move.from_);
+                staged[move.to_].push_back({0, move.symbol_, name, {}, ShardEventKind::MIGRATE_IN, &handoff});
+                if (staged[move.to_].size() == SHARD_BATCH_SIZE) {
+                    flush(move.to_);
+                }
+            }
+        }
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        flush(i);
+        workers[i]->inputClosed_.store(true, std::memory_order_release);
+    }
+    totalEvents.store(sequence, std::memory_order_relaxed);
+    ingressDone.store(true, std::memory_order_release);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    merger.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t rejected = 0;
+    std::uint64_t migrations = 0;
+    for (const auto& worker : workers) {
+        rejected += worker->rejected_;
+        migrations += worker->migratedIn_;
+    }
+
+    mute.reset();
+    std::ostream& out = std::cout;
+    out << "Sharded replay of " << filename << " on " << workerCount << " worker(s)\n";
+    out << "=================================================\n";
+    for (unsigned i = 0; i < workerCount; ++i) {
+        const ShardWorker& worker = *workers[i];
+        double busy = seconds > 0 ? static_cast<double>(worker.busyNanos_) / 1e9 / seconds * 100.0 : 0.0;
+        out << "Worker " << i << " (cpu " << worker.cpu_ << "): " << worker.symbols_ << " symbol(s), "
+            << worker.events_ << " event(s), " << worker.trades_ << " trade(s), " << worker.migratedIn_
+            << " book(s) in, " << worker.migratedOut_ << " out, " << std::fixed << std::setprecision(1) << busy
+            << "% busy\n";
+    }
+    out << "=================================================\n";
+    out << "Sharded Replay Complete!\n";
+    out << "Lines processed: " << reader.getLineNumber() << "\n";
+    out << "Events routed: " << sequence << " (" << rejected << " rejected, " << missingSymbol << " without symbol)\n";
+    out << "Symbols: " << symbolNames.size() << "\n";
+    if (rebalance && workerCount > 1) {
+        out << "Rebalancing: " << migrations << " book(s) moved in " << rounds << " round(s)\n";
+    } else {
+        out << "Rebalancing: off\n";
+    }
+    out << "Total trades executed: " << mergeStats.trades_ << "\n";
+    out << "Merged results: " << mergeStats.results_ << (output ? " written to " + outputPath : std::string()) << "\n";
+    out << "Elapsed: " << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms, "
+        << std::setprecision(0) << (seconds > 0 ? static_cast<double>(sequence) / seconds : 0.0) << " events/s\n";
+
+    if (mergeStats.writeFailed_) {
+        std::cerr << "Error: Failed writing " << outputPath << std::endl;
+        return false;
+    }
+    return true;
+}
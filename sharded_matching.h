@@ -0,0 +1,103 @@
+/**
+ * Sharded Matching Module
+ * Partitions symbols across pinned worker threads that each own their books outright,
+ * and merges their results back into one stream in input order
+ */
+
+#pragma once
+
+#include "book_manager.h"   // SymbolId
+#include "order_command.h"
+#include "orderbook.h"
+#include "trade_tape.h"
+#include <atomic>
+#include <string>
+
+constexpr std::size_t SHARD_RING_CAPACITY = 1 << 14;  // Events (and results) buffered per worker
+constexpr std::size_t SHARD_BATCH_SIZE = 256;         // Events moved per ring operation
+constexpr std::size_t SHARD_REASON_BYTES = 48;        // Reject reason kept in a result
+constexpr std::uint64_t SHARD_REBALANCE_INTERVAL = 1 << 16; // Events routed between rebalance rounds
+constexpr std::size_t SHARD_MAX_MIGRATIONS = 16;      // Books moved per rebalance round at most
+constexpr double SHARD_IMBALANCE_TOLERANCE = 0.10;    // Worker load allowed above the mean before moving books
+
+enum class ShardEventKind : std::uint8_t
+{
+    COMMAND,     // Match command_ against the symbol's book
+    MIGRATE_OUT, // Release the symbol's book into handoff_
+    MIGRATE_IN   // Wait for handoff_ and adopt the symbol's book
+};
+
+/**
+ * Mailbox carrying one book from the worker giving it up to the worker taking it over
+ */
+struct ShardHandoff
+{
+    std::atomic<OrderBook*> book_{nullptr}; // Released book (null if the old worker never built one)
+    std::atomic<bool> ready_{false};        // Set once the old worker has released the book
+};
+
+/**
+ * Command or migration step routed to a worker
+ */
+struct ShardEvent
+{
+    std::uint64_t sequence_;     // Position in the input (1-based; 0 for migration steps)
+    SymbolId symbol_;            // Book the command is for
+    const std::string* name_;    // Symbol name (owned by the ingress table; stable)
+    OrderCommand command_;
+    ShardEventKind kind_ = ShardEventKind::COMMAND;
+    ShardHandoff* handoff_ = nullptr; // Migration steps only (owned by ingress)
+};
+
+enum class ShardResultKind : std::uint8_t
+{
+    TRADE,  // One trade produced by the command
+    ACK,    // Command applied (last result of its sequence)
+    REJECT  // Command refused (last result of its sequence)
+};
+
+/**
+ * Result produced by a worker
+ * Every sequence yields zero or more TRADE results followed by exactly one ACK or REJECT
+ */
+struct ShardResult
+{
+    std::uint64_t sequence_;
+    const std::string* name_;
+    ShardResultKind kind_;
+    OrderAction action_;
+    bool resting_;                     // ACK: order rests after the command
+    OrderId orderId_;                  // ACK/REJECT: command's order; TRADE: bid order
+    OrderId counterId_;                // TRADE: ask order
+    std::int32_t price_;               // TRADE price
+    std::uint32_t quantity_;           // TRADE quantity
+    std::optional<OrderSide> aggressor_; // TRADE: side of the incoming order
+    char reason_[SHARD_REASON_BYTES];  // REJECT: engine message (truncated, NUL terminated)
+};
+
+/**
+ * Replay a multi-symbol CSV file on sharded workers
+ * The calling thread parses and routes: each symbol is assigned to a worker the first time it
+ * appears (round robin) and every later command for it goes to that worker's SPSC queue. Workers
+ * are pinned to CPUs and match without locks. A merger thread takes each worker's results and
+ * writes them in input sequence as CSV lines:
+ *   <seq>,TRADE,<symbol>,<bid_id>,<ask_id>,<price>,<quantity>
+ *   <seq>,ACK,<symbol>,<action>,<order_id>,<RESTING|DONE>
+ *   <seq>,REJECT,<symbol>,<action>,<order_id>,<reason>
+ * Every row needs a symbol column and order ids are scoped per symbol. The engine log is muted.
+ *
+ * With rebalancing on, ingress keeps a decaying message rate per symbol and, every
+ * SHARD_REBALANCE_INTERVAL events, moves the coldest books that help off the busiest worker onto
+ * the idlest one. A move is a quiesce-and-handoff through the queues: the old worker gets a
+ * MIGRATE_OUT after the symbol's last command, the new worker a MIGRATE_IN before its next one,
+ * and the new worker waits on the handoff before touching the book. Per-symbol order is kept, so
+ * the merged stream is the same with or without moves.
+ * @param filename Path to CSV file
+ * @param workers Number of matching threads (0 uses the hardware concurrency)
+ * @param outputPath File receiving the merged stream (empty to only count results)
+ * @param rebalance Migrate books between workers as their load shifts
+ * @param tape Optional tape receiving every trade in input order (written by the merger)
+ * @return false if the input or output could not be opened
+ */
+bool processShardedFile(const std::string& filename, unsigned workers, const std::string& outputPath,
+                        bool rebalance = true, TradeTape* tape = nullptr);
@@ -0,0 +1,415 @@
+/**
+ * Shared-Memory Order Entry Implementation
+ * Segment setup, the polling engine loop and the client handle
+ */
+
+#include "shm_transport.h"
+#include "console_mute.h"       // Engine log suppression while serving
+#include "latency_histogram.h"  // Client round-trip latency
+#include "order_router.h"       // Order ownership and fill routing
+#include <fcntl.h>
+#include <sys/mman.h>           // shm_open/mmap
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <new>                  // Placement new of the segment
+#include <random>
+#include <vector>
+
+namespace {
+
+volatile std::sig_atomic_t shmStopRequested = 0;
+
+void requestShmStop(int) {
+    shmStopRequested = 1;
+}
+
+std::string segmentName(const std::string& name) {
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+std::uint64_t steadyNanos() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Counters reported when the engine stops
+ */
+struct ShmEngineStats
+{
+    std::uint64_t attaches_ = 0;  // Client generations served
+    std::uint64_t messages_ = 0;  // Requests applied or rejected
+    std::uint64_t rejected_ = 0;  // Requests refused (by the engine or the ownership checks)
+    std::uint64_t trades_ = 0;    // Trades executed
+    std::uint64_t faulted_ = 0;   // Clients dropped for a full response ring
+};
+
+/**
+ * Engine-side view of one slot
+ */
+struct EngineSlot
+{
+    std::uint64_t generation_ = 0; // Generation being served
+    ShmRingConsumer<ShmRequest, SHM_REQUEST_RING_SLOTS> requests_;
+    ShmRingProducer<ShmResponse, SHM_RESPONSE_RING_SLOTS> responses_;
+};
+
+/**
+ * Owner of a resting order, for routing fills
+ */
+struct SlotRef
+{
+    std::size_t slot_;
+    std::uint64_t generation_;
+
+    bool operator==(const SlotRef&) const = default;
+};
+
+/**
+ * Polling engine over a mapped segment
+ */
+class ShmEngine
+{
+    public:
+    ShmEngine(ShmSegment& segment, OrderBook& orderBook, TradeTape* tape) :
+        segment_(segment), router_(orderBook, tape), tape_(tape) {
+        for (std::size_t i = 0; i < SHM_CLIENT_SLOTS; ++i) {
+            slots_[i].requests_.bind(&segment.slots_[i].requests_);
+            slots_[i].responses_.bind(&segment.slots_[i].responses_);
+        }
+    }
+
+    ShmEngineStats getStats() const {
+        ShmEngineStats stats = stats_;
+        stats.rejected_ = router_.getRejected();
+        stats.trades_ = router_.getTrades();
+        return stats;
+    }
+
+    /**
+     * Poll until a stop signal arrives
+     */
+    void run() {
+        ShmRequest batch[SHM_DISPATCH_BATCH];
+        SpinWait idle;
+
+        while (!shmStopRequested) {
+            std::uint64_t applied = 0;
+            for (std::size_t i = 0; i < SHM_CLIENT_SLOTS; ++i) {
+                ShmClientSlot& shared = segment_.slots_[i];
+                if (shared.state_.load(std::memory_order_acquire) != ShmSlotState::ACTIVE) {
+                    continue;
+                }
+                std::uint64_t first = slots_[i].requests_.getHead();
+                std::size_t count = slots_[i].requests_.popBatch(batch, SHM_DISPATCH_BATCH);
+
+                // Checked after popping: a client may have attached since the state was read, and
+                // any of its requests in the batch were published after its generation
+                std::size_t skip = 0;
+                std::uint64_t generation = shared.generation_.load(std::memory_order_acquire);
+                if (generation != slots_[i].generation_) {
+                    // Requests a previous client left unread must not run as the new client's
+                    std::uint64_t start = shared.firstRequest_.load(std::memory_order_relaxed);
+                    skip = start > first ? static_cast<std::size_t>(std::min<std::uint64_t>(count, start - first)) : 0;
+                    slots_[i].generation_ = generation;
+                    slots_[i].requests_.discardUntil(start);
+                    stats_.attaches_++;
+                }
+
+                for (std::size_t j = skip; j < count; ++j) {
+                    apply(i, batch[j]);
+                }
+                applied += count - skip;
+            }
+
+            if (applied == 0) {
+                idle.wait();
+                continue;
+            }
+            idle.reset();
+            stats_.messages_ += applied;
+            if (tape_) {
+                tape_->commit();
+            }
+        }
+    }
+
+    private:
+    void apply(std::size_t slot, const ShmRequest& request) {
+        std::uint64_t generation = slots_[slot].generation_;
+        GatewayResponse ack = router_.apply({slot, generation}, request.command_,
+            [this](const SlotRef& owner, const GatewayResponse& fill) {
+                send(owner.slot_, owner.generation_, 0, fill);
+            });
+        send(slot, generation, request.sequence_, ack);
+    }
+
+    void send(std::size_t slot, std::uint64_t generation, std::uint64_t sequence, const GatewayResponse& response) {
+        ShmClientSlot& shared = segment_.slots_[slot];
+        if (shared.state_.load(std::memory_order_acquire) != ShmSlotState::ACTIVE ||
+            shared.generation_.load(std::memory_order_relaxed) != generation) {
+            return; // Client left; its fills have nowhere to go
+        }
+        if (!slots_[slot].responses_.tryPush({generation, sequence, response})) {
+            // Not reading its responses; stop serving it rather than stall the book
+            ShmSlotState active = ShmSlotState::ACTIVE;
+            if (shared.state_.compare_exchange_strong(active, ShmSlotState::FAULTED, std::memory_order_acq_rel)) {
+                stats_.faulted_++;
+            }
+        }
+    }
+
+    ShmSegment& segment_;
+    OrderRouter<SlotRef> router_;  // Ownership checks and response routing
+    TradeTape* tape_;
+    EngineSlot slots_[SHM_CLIENT_SLOTS];
+    ShmEngineStats stats_;
+};
+
+} // namespace
+
+bool ShmOrderClient::attach(const std::string& name) {
+    detach();
+    std::string path = segmentName(name);
+    int fd = ::shm_open(path.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open shared memory segment " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat info{};
+    void* mapping = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) == sizeof(ShmSegment)) {
+        mapping = ::mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Shared memory segment " << path << " has the wrong size or cannot be mapped" << std::endl;
+        return false;
+    }
+
+    ShmSegment* segment = static_cast<ShmSegment*>(mapping);
+    if (std::memcmp(segment->magic_, SHM_SEGMENT_MAGIC, sizeof(SHM_SEGMENT_MAGIC)) != 0 ||
+        segment->version_ != SHM_SEGMENT_VERSION ||
+        segment->engineState_.load(std::memory_order_acquire) != ShmEngineState::RUNNING) {
+        std::cerr << "Error: No running engine behind shared memory segment " << path << std::endl;
+        ::munmap(mapping, sizeof(ShmSegment));
+        return false;
+    }
+
+    for (std::size_t i = 0; i < segment->slotCount_; ++i) {
+        ShmClientSlot& slot = segment->slots_[i];
+        ShmSlotState expected = ShmSlotState::FREE;
+        if (!slot.state_.compare_exchange_strong(expected, ShmSlotState::CLAIMED, std::memory_order_acq_rel)) {
+            continue;
+        }
+        // The engine ignores CLAIMED slots, so the rings can be taken over without racing it
+        segment_ = segment;
+        slot_ = i;
+        requests_.bind(&slot.requests_);
+        slot.firstRequest_.store(slot.requests_.tail_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        // Released after firstRequest_: an engine that sees the new generation also sees where it starts
+        generation_ = slot.generation_.load(std::memory_order_relaxed) + 1;
+        slot.generation_.store(generation_, std::memory_order_release);
+        responses_.bind(&slot.responses_);
+        responses_.discard();
+        slot.state_.store(ShmSlotState::ACTIVE, std::memory_order_release);
+        return true;
+    }
+
+    std::cerr << "Error: All " << segment->slotCount_ << " client slots of " << path << " are in use" << std::endl;
+    ::munmap(mapping, sizeof(ShmSegment));
+    return false;
+}
+
+void ShmOrderClient::detach() {
+    if (!segment_) {
+        return;
+    }
+    segment_->slots_[slot_].state_.store(ShmSlotState::FREE, std::memory_order_release);
+    ::munmap(segment_, sizeof(ShmSegment));
+    segment_ = nullptr;
+}
+
+bool ShmOrderClient::submit(const OrderCommand& command, std::uint64_t& sequence) {
+    if (!requests_.tryPush({nextSequence_ + 1, command})) {
+        return false;
+    }
+    sequence = ++nextSequence_;
+    return true;
+}
+
+bool ShmOrderClient::poll(ShmResponse& response) {
+    while (responses_.tryPop(response)) {
+        if (response.generation_ == generation_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ShmOrderClient::isServed() const {
+    return segment_ &&
+           segment_->engineState_.load(std::memory_order_acquire) == ShmEngineState::RUNNING &&
+           segment_->slots_[slot_].state_.load(std::memory_order_acquire) == ShmSlotState::ACTIVE;
+}
+
+bool runShmEngine(const std::string& name, OrderBook& orderBook, TradeTape* tape) {
+    std::string path = segmentName(name);
+    int fd = ::shm_open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot create shared memory segment " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    void* mapping = MAP_FAILED;
+    if (::ftruncate(fd, sizeof(ShmSegment)) == 0) {
+        mapping = ::mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Cannot map shared memory segment " << path << ": " << std::strerror(errno) << std::endl;
+        ::shm_unlink(path.c_str());
+        return false;
+    }
+
+    // A fresh segment is zero-filled; construct it in place and publish RUNNING last
+    ShmSegment* segment = new (mapping) ShmSegment;
+    std::memcpy(segment->magic_, SHM_SEGMENT_MAGIC, sizeof(SHM_SEGMENT_MAGIC));
+    segment->version_ = SHM_SEGMENT_VERSION;
+    segment->slotCount_ = static_cast<std::uint32_t>(SHM_CLIENT_SLOTS);
+    for (ShmClientSlot& slot : segment->slots_) {
+        slot.state_.store(ShmSlotState::FREE, std::memory_order_relaxed);
+        slot.generation_.store(0, std::memory_order_relaxed);
+        slot.firstRequest_.store(0, std::memory_order_relaxed);
+        slot.requests_.head_.store(0, std::memory_order_relaxed);
+        slot.requests_.tail_.store(0, std::memory_order_relaxed);
+        slot.responses_.head_.store(0, std::memory_order_relaxed);
+        slot.responses_.tail_.store(0, std::memory_order_relaxed);
+    }
+
+    ShmEngine engine(*segment, orderBook, tape);
+    shmStopRequested = 0;
+    auto previousInt = std::signal(SIGINT, requestShmStop);
+    auto previousTerm = std::signal(SIGTERM, requestShmStop);
+    segment->engineState_.store(ShmEngineState::RUNNING, std::memory_order_release);
+
+    std::cout << "Shared memory engine serving " << path << " (" << SHM_CLIENT_SLOTS
+              << " client slots, Ctrl-C to stop)" << std::endl;
+    {
+        ConsoleMute mute;
+        engine.run();
+    }
+
+    segment->engineState_.store(ShmEngineState::STOPPED, std::memory_order_release);
+    std::signal(SIGINT, previousInt);
+    std::signal(SIGTERM, previousTerm);
+    ::munmap(mapping, sizeof(ShmSegment));
+    ::shm_unlink(path.c_str());
+
+    ShmEngineStats stats = engine.getStats();
+    std::cout << "=================================================\n";
+    std::cout << "Shared Memory Engine Stopped!\n";
+    std::cout << "Client attaches served: " << stats.attaches_ << "\n";
+    std::cout << "Messages processed: " << stats.messages_ << " (" << stats.rejected_ << " rejected)\n";
+    std::cout << "Total trades executed: " << stats.trades_ << "\n";
+    std::cout << "Final order book size: " << orderBook.getSize() << " orders\n";
+    if (stats.faulted_ != 0) {
+        std::cout << "Clients faulted for full response rings: " << stats.faulted_ << "\n";
+    }
+    return true;
+}
+
+bool runShmClientBenchmark(const std::string& name, std::uint64_t orders) {
+    ShmOrderClient client;
+    if (!client.attach(name)) {
+        return false;
+    }
+
+    // Order ids unique per slot and attach so clients never collide
+    OrderId nextId = ((client.getSlot() + 1) * 1'000'000 + client.getGeneration() % 1'000'000) * 1'000'000'000ull;
+    std::mt19937_64 random(client.getSlot() * 7919 + client.getGeneration());
+    std::vector<OrderId> resting;
+    LatencyHistogram latency;
+    std::uint64_t fills = 0;
+    std::uint64_t rejects = 0;
+    std::uint64_t acknowledged = 0;
+    bool ok = true;
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::uint64_t i = 0; i < orders && ok; ++i) {
+        OrderCommand command{};
+        if (!resting.empty() && random() % 4 == 0) {
+            std::size_t index = static_cast<std::size_t>(random() % resting.size());
+            command.action_ = OrderAction::CANCEL;
+            command.orderId_ = resting[index];
+            resting[index] = resting.back();
+            resting.pop_back();
+        } else {
+            command.action_ = OrderAction::CREATE;
+            command.orderId_ = nextId++;
+            command.side_ = random() % 2 ? OrderSide::BUY : OrderSide::SELL;
+            command.type_ = OrderType::GTC;
+            command.price_ = static_cast<std::int32_t>(95 + random() % 11);
+            command.quantity_ = static_cast<std::uint32_t>(1 + random() % 100);
+        }
+
+        std::uint64_t sequence = 0;
+        command.timestamp_ = steadyNanos();
+        SpinWait wait;
+        while (!client.submit(command, sequence)) {
+            wait.wait();
+        }
+
+        // Spin for the ACK/REJECT of this request, counting fills on the way
+        bool answered = false;
+        wait.reset();
+        std::uint64_t deadline = command.timestamp_ + 5'000'000'000ull;
+        while (!answered) {
+            ShmResponse response;
+            if (!client.poll(response)) {
+                if (!client.isServed() || steadyNanos() > deadline) {
+                    std::cerr << "Error: engine stopped answering after " << acknowledged << " request(s)" << std::endl;
+                    ok = false;
+                    break;
+                }
+                wait.wait();
+                continue;
+            }
+            wait.reset();
+            if (response.response_.type_ == GatewayResponseType::FILL) {
+                fills++;
+                continue;
+            }
+            if (response.sequence_ != sequence) {
+                continue; // Answer to an earlier request that timed out
+            }
+            latency.record(steadyNanos() - response.response_.aux_);
+            acknowledged++;
+            answered = true;
+            if (response.response_.type_ == GatewayResponseType::REJECT) {
+                rejects++;
+            } else if (command.action_ == OrderAction::CREATE && response.response_.status_ == 1) {
+                resting.push_back(command.orderId_);
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "=================================================\n";
+    std::cout << "Shared Memory Client Complete! (slot " << client.getSlot() << ")\n";
+    std::cout << "Requests acknowledged: " << acknowledged << " (" << rejects << " rejected), fills received: "
+              << fills << "\n";
+    std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms, "
+              << std::setprecision(0) << (seconds > 0 ? static_cast<double>(acknowledged) / seconds : 0.0)
+              << " requests/s\n";
+    std::cout << "Order-to-ack round trip (ns): min " << latency.min()
+              << " p50 " << latency.percentile(50) << " p90 " << latency.percentile(90)
+              << " p99 " << latency.percentile(99) << " p99.9 " << latency.percentile(99.9)
+              << " max " << latency.max() << " mean " << std::setprecision(0) << latency.mean() << "\n";
+    return ok;
+}
@@ -0,0 +1,294 @@
+/**
+ * Shared-Memory Order Entry Module
+ * Order entry for co-located clients through SPSC rings in a named POSIX shared memory segment
+ *
+ * The segment holds a fixed number of client slots. Each slot has a request ring (client to
+ * engine) and a response ring (engine to client). Head and tail indices sit on their own cache
+ * lines, and every request carries a client sequence number that its ACK or REJECT echoes.
+ * Responses reuse the gateway's ACK/FILL/REJECT layout (see tcp_gateway.h). Ring entries are
+ * raw structs, so the engine and its clients must come from the same build.
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "order_command.h"
+#include "spsc_ring.h"   // CACHE_LINE_SIZE
+#include "tcp_gateway.h" // GatewayResponse
+#include "trade_tape.h"
+#include <atomic>
+#include <string>
+#include <type_traits>
+
+constexpr char SHM_SEGMENT_MAGIC[8] = {'O', 'B', 'S', 'H', 'M', 0, 0, 0};
+constexpr std::uint32_t SHM_SEGMENT_VERSION = 2;
+constexpr std::size_t SHM_CLIENT_SLOTS = 16;
+constexpr std::size_t SHM_REQUEST_RING_SLOTS = 1024;
+constexpr std::size_t SHM_RESPONSE_RING_SLOTS = 4096;
+constexpr std::size_t SHM_DISPATCH_BATCH = 64; // Requests taken from one slot per pass
+
+/**
+ * Request entry: one command with the client's sequence number
+ */
+struct ShmRequest
+{
+    std::uint64_t sequence_;
+    OrderCommand command_;
+};
+
+/**
+ * Response entry
+ */
+struct ShmResponse
+{
+    std::uint64_t generation_;  // Slot generation of the client it is meant for
+    std::uint64_t sequence_;    // Sequence of the request (0 for FILL)
+    GatewayResponse response_;
+};
+
+/**
+ * Ring storage as laid out in shared memory
+ * Holds only the published indices and the slots; each side keeps its cached view of the
+ * other's index in process-local memory (ShmRingProducer/ShmRingConsumer).
+ * @tparam T Trivially copyable entry type
+ * @tparam Capacity Number of slots (power of two)
+ */
+template<typename T, std::size_t Capacity>
+struct ShmRing
+{
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "entries are copied through shared memory");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "indices must be address-free");
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> head_; // Next entry to read (consumer)
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> tail_; // Next entry to write (producer)
+    alignas(CACHE_LINE_SIZE) T slots_[Capacity];
+};
+
+/**
+ * Producer side of a shared ring (one process or thread only)
+ */
+template<typename T, std::size_t Capacity>
+class ShmRingProducer
+{
+    public:
+    /**
+     * Bind to a ring, continuing from its current tail
+     */
+    void bind(ShmRing<T, Capacity>* ring) {
+        ring_ = ring;
+        tail_ = ring->tail_.load(std::memory_order_relaxed);
+        cachedHead_ = ring->head_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Append one entry
+     * @return false if the ring is full
+     */
+    bool tryPush(const T& item) {
+        if (tail_ - cachedHead_ == Capacity) {
+            cachedHead_ = ring_->head_.load(std::memory_order_acquire);
+            if (tail_ - cachedHead_ == Capacity) {
+                return false;
+            }
+        }
+        ring_->slots_[tail_ & (Capacity - 1)] = item;
+        ring_->tail_.store(++tail_, std::memory_order_release);
+        return true;
+    }
+
+    private:
+    ShmRing<T, Capacity>* ring_ = nullptr;
+    std::uint64_t tail_ = 0;       // Private copy of the published tail
+    std::uint64_t cachedHead_ = 0; // Last consumer head seen
+};
+
+/**
+ * Consumer side of a shared ring (one process or thread only)
+ */
+template<typename T, std::size_t Capacity>
+class ShmRingConsumer
+{
+    public:
+    /**
+     * Bind to a ring, continuing from its current head
+     */
+    void bind(ShmRing<T, Capacity>* ring) {
+        ring_ = ring;
+        head_ = ring->head_.load(std::memory_order_relaxed);
+        cachedTail_ = head_;
+    }
+
+    /**
+     * Skip everything already in the ring
+     */
+    void discard() {
+        head_ = ring_->tail_.load(std::memory_order_acquire);
+        cachedTail_ = head_;
+        ring_->head_.store(head_, std::memory_order_release);
+    }
+
+    /**
+     * Skip the entries before a position, keeping any written after it
+     * @param position Free-running index of the first entry to keep (never behind the head)
+     */
+    void discardUntil(std::uint64_t position) {
+        if (position > head_) {
+            head_ = position;
+            cachedTail_ = position;
+            ring_->head_.store(head_, std::memory_order_release);
+        }
+    }
+
+    /**
+     * Free-running index of the next entry popBatch returns
+     */
+    std::uint64_t getHead() const { return head_; }
+
+    /**
+     * Take up to maxCount entries, releasing their slots with one store
+     * @return Number of entries taken
+     */
+    std::size_t popBatch(T* items, std::size_t maxCount) {
+        if (cachedTail_ == head_) {
+            cachedTail_ = ring_->tail_.load(std::memory_order_acquire);
+        }
+        std::size_t available = static_cast<std::size_t>(cachedTail_ - head_);
+        std::size_t popped = maxCount < available ? maxCount : available;
+        for (std::size_t i = 0; i < popped; ++i) {
+            items[i] = ring_->slots_[(head_ + i) & (Capacity - 1)];
+        }
+        if (popped != 0) {
+            head_ += popped;
+            ring_->head_.store(head_, std::memory_order_release);
+        }
+        return popped;
+    }
+
+    bool tryPop(T& item) { return popBatch(&item, 1) == 1; }
+
+    private:
+    ShmRing<T, Capacity>* ring_ = nullptr;
+    std::uint64_t head_ = 0;       // Private copy of the published head
+    std::uint64_t cachedTail_ = 0; // Last producer tail seen
+};
+
+using ShmRequestRing = ShmRing<ShmRequest, SHM_REQUEST_RING_SLOTS>;
+using ShmResponseRing = ShmRing<ShmResponse, SHM_RESPONSE_RING_SLOTS>;
+
+enum class ShmSlotState : std::uint32_t
+{
+    FREE,    // No client
+    CLAIMED, // A client is attaching; the engine ignores the slot
+    ACTIVE,  // Engine polls the request ring
+    FAULTED  // Client fell behind on responses; the engine stopped serving it
+};
+
+enum class ShmEngineState : std::uint32_t
+{
+    STARTING,
+    RUNNING,
+    STOPPED
+};
+
+/**
+ * One client's rings
+ */
+struct ShmClientSlot
+{
+    alignas(CACHE_LINE_SIZE) std::atomic<ShmSlotState> state_;
+    std::atomic<std::uint64_t> generation_; // Bumped by each attaching client
+    std::atomic<std::uint64_t> firstRequest_; // Request ring tail when the current generation attached
+    ShmRequestRing requests_;
+    ShmResponseRing responses_;
+};
+
+/**
+ * Whole shared segment
+ */
+struct ShmSegment
+{
+    char magic_[8];
+    std::uint32_t version_;
+    std::uint32_t slotCount_;
+    alignas(CACHE_LINE_SIZE) std::atomic<ShmEngineState> engineState_;
+    ShmClientSlot slots_[SHM_CLIENT_SLOTS];
+};
+
+/**
+ * Client handle on an engine's segment
+ */
+class ShmOrderClient
+{
+    public:
+    ShmOrderClient() = default;
+    ~ShmOrderClient() { detach(); }
+
+    ShmOrderClient(const ShmOrderClient&) = delete;
+    ShmOrderClient& operator=(const ShmOrderClient&) = delete;
+
+    /**
+     * Map a running engine's segment and claim a free slot
+     * @param name Segment name (a leading '/' is added if missing)
+     * @return false with a message on stderr if the segment is missing, incompatible or full
+     */
+    bool attach(const std::string& name);
+
+    /**
+     * Release the slot and unmap the segment
+     */
+    void detach();
+
+    /**
+     * Send one command
+     * @param command Command to send (its timestamp is echoed in the ACK/REJECT aux field)
+     * @param sequence Receives the sequence number assigned to the request
+     * @return false if the request ring is full
+     */
+    bool submit(const OrderCommand& command, std::uint64_t& sequence);
+
+    /**
+     * Take the next response meant for this client
+     * @param response Receives the response
+     * @return false if none is waiting
+     */
+    bool poll(ShmResponse& response);
+
+    /**
+     * Check whether the engine is still serving this client
+     */
+    bool isServed() const;
+
+    std::size_t getSlot() const { return slot_; }
+    std::uint64_t getGeneration() const { return generation_; }
+
+    private:
+    ShmSegment* segment_ = nullptr;
+    std::size_t slot_ = 0;
+    std::uint64_t generation_ = 0;
+    std::uint64_t nextSequence_ = 0;
+    ShmRingProducer<ShmRequest, SHM_REQUEST_RING_SLOTS> requests_;
+    ShmRingConsumer<ShmResponse, SHM_RESPONSE_RING_SLOTS> responses_;
+};
+
+/**
+ * Create a segment and serve its clients until SIGINT or SIGTERM
+ * The engine thread busy-polls every active slot, applies requests straight to the book and
+ * pushes responses back; ownership checks and fill routing are the gateway's (OrderRouter).
+ * Requests a previous client of a slot left unread are skipped when the next one attaches. A client whose
+ * response ring is full is marked FAULTED instead of blocking the book. The segment is
+ * unlinked on exit. The engine's console log is suppressed while serving.
+ * @param name Segment name (a leading '/' is added if missing)
+ * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade (committed after each polling pass with work)
+ * @return false if the segment could not be created
+ */
+bool runShmEngine(const std::string& name, OrderBook& orderBook, TradeTape* tape = nullptr);
+
+/**
+ * Attach to an engine and measure order-to-ack round trips, one request in flight at a time
+ * @param name Segment name
+ * @param orders Requests to send (new limit orders with some cancels of resting ones)
+ * @return false if attaching failed or the engine stopped answering
+ */
+bool runShmClientBenchmark(const std::string& name, std::uint64_t orders);
@@ -0,0 +1,163 @@
+/**
+ * Single-Producer/Single-Consumer Ring Module
+ * Lock-free bounded queue for handing work between exactly two threads
+ */
+
+#pragma once
+
+#include <atomic>       // Head/tail publication
+#include <cstddef>
+#include <memory>       // Slot storage
+#include <stdexcept>    // Capacity validation
+#include <thread>       // Back-off while waiting
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>  // _mm_pause
+#endif
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * Hint to the CPU that the caller is spinning on a shared variable
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * Spin-then-yield back-off for threads waiting on a ring
+ * Spins briefly to catch short gaps cheaply, then yields so a waiting thread does not
+ * steal the CPU from its peer when the two share a core
+ */
+class SpinWait
+{
+    public:
+    void wait() {
+        if (spins_ < SPIN_LIMIT) {
+            cpuRelax();
+            spins_++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() { spins_ = 0; }
+
+    private:
+    static constexpr unsigned SPIN_LIMIT = 128;
+    unsigned spins_ = 0;
+};
+
+/**
+ * Bounded lock-free SPSC ring
+ * Producer and consumer indices live on separate cache lines, and each side keeps a
+ * private copy of the other's index so it only touches the shared line when the ring
+ * looks full (producer) or empty (consumer). Batch operations publish many slots with
+ * one release store.
+ * @tparam T Trivially copyable element type
+ */
+template<typename T>
+class SpscRing
+{
+    public:
+    /**
+     * Create a ring
+     * @param capacity Number of slots (must be a power of two)
+     * @throws std::invalid_argument if capacity is not a power of two
+     */
+    explicit SpscRing(std::size_t capacity) : slots_(new T[capacity]), capacity_(capacity), mask_(capacity - 1) {
+        if (capacity == 0 || (capacity & mask_) != 0) {
+            throw std::invalid_argument("SPSC ring capacity must be a power of two");
+        }
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * Push as many items as fit (producer thread only)
+     * @param items Items to push
+     * @param count Number of items
+     * @return Number of items pushed
+     */
+    std::size_t pushBatch(const T* items, std::size_t count) {
+        const std::size_t tail = producer_.tail_.load(std::memory_order_relaxed);
+        std::size_t free = capacity_ - (tail - producer_.cachedHead_);
+        if (free < count) {
+            producer_.cachedHead_ = consumer_.head_.load(std::memory_order_acquire);
+            free = capacity_ - (tail - producer_.cachedHead_);
+        }
+
+        std::size_t pushed = count < free ? count : free;
+        for (std::size_t i = 0; i < pushed; ++i) {
+            slots_[(tail + i) & mask_] = items[i];
+        }
+        if (pushed != 0) {
+            producer_.tail_.store(tail + pushed, std::memory_order_release);
+        }
+        return pushed;
+    }
+
+    /**
+     * Push one item (producer thread only)
+     * @param item Item to push
+     * @return false if the ring is full
+     */
+    bool tryPush(const T& item) { return pushBatch(&item, 1) == 1; }
+
+    /**
+     * Pop up to maxCount items (consumer thread only)
+     * @param items Destination buffer
+     * @param maxCount Capacity of the destination
+     * @return Number of items popped
+     */
+    std::size_t popBatch(T* items, std::size_t maxCount) {
+        const std::size_t head = consumer_.head_.load(std::memory_order_relaxed);
+        std::size_t available = consumer_.cachedTail_ - head;
+        if (available == 0) {
+            consumer_.cachedTail_ = producer_.tail_.load(std::memory_order_acquire);
+            available = consumer_.cachedTail_ - head;
+        }
+
+        std::size_t popped = maxCount < available ? maxCount : available;
+        for (std::size_t i = 0; i < popped; ++i) {
+            items[i] = slots_[(head + i) & mask_];
+        }
+        if (popped != 0) {
+            consumer_.head_.store(head + popped, std::memory_order_release);
+        }
+        return popped;
+    }
+
+    /**
+     * Pop one item (consumer thread only)
+     * @param item Receives the item
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& item) { return popBatch(&item, 1) == 1; }
+
+    std::size_t capacity() const { return capacity_; }
+
+    private:
+    struct alignas(CACHE_LINE_SIZE) ProducerSide
+    {
+        std::atomic<std::size_t> tail_{0}; // Next slot to write (published to the consumer)
+        std::size_t cachedHead_ = 0;       // Producer's last view of the consumer head
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ConsumerSide
+    {
+        std::atomic<std::size_t> head_{0}; // Next slot to read (published to the producer)
+        std::size_t cachedTail_ = 0;       // Consumer's last view of the producer tail
+    };
+
+    ProducerSide producer_;
+    ConsumerSide consumer_;
+    alignas(CACHE_LINE_SIZE) std::unique_ptr<T[]> slots_;
+    std::size_t capacity_;
+    std::size_t mask_;
+};
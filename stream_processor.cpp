@@ -0,0 +1,161 @@
+/**
+ * Streaming Ingestion Implementation
+ * Chunked reads, in-place decoding and one output write per input chunk
+ */
+
+#include "stream_processor.h"
+#include "console_mute.h"   // Engine log suppression
+#include "csv_processor.h"  // Command decoding
+#include "order_command.h"
+#include <cerrno>
+#include <charconv>         // Allocation-free number formatting
+#include <cstring>          // memrchr/memmove for partial lines
+#include <fcntl.h>          // open
+#include <unistd.h>         // read/write/close
+#include <vector>
+
+namespace {
+
+const char* actionName(OrderAction action) {
+    switch (action) {
+        case OrderAction::CREATE: return "CREATE";
+        case OrderAction::MODIFY: return "MODIFY";
+        case OrderAction::CANCEL: return "CANCEL";
+    }
+    return "UNKNOWN";
+}
+
+void appendNumber(std::string& out, std::uint64_t value) {
+    char digits[20];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, end);
+}
+
+bool writeAll(int fd, const std::string& data) {
+    std::size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+bool processOrderStream(int inputFd, int outputFd, OrderBook& orderBook, TradeTape* tape) {
+    ConsoleMute mute;
+    std::vector<char> buffer(STREAM_READ_BYTES);
+    std::size_t filled = 0;
+    std::size_t streamOffset = 0;
+    int lineNumber = 0;
+    std::uint64_t commands = 0;
+    std::uint64_t totalTrades = 0;
+    bool endOfInput = false;
+    bool ok = true;
+    std::string output;
+    OrderCommand command;
+
+    while (!endOfInput) {
+        if (filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2); // Only reached when one line fills the whole buffer
+        }
+
+        ssize_t n = ::read(inputFd, buffer.data() + filled, buffer.size() - filled);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error reading order stream: " << std::strerror(errno) << std::endl;
+            ok = false;
+            endOfInput = true;
+        } else if (n == 0) {
+            endOfInput = true;
+        }
+        filled += n > 0 ? static_cast<std::size_t>(n) : 0;
+
+        // Apply complete lines only; a partial last line waits for the next read
+        std::size_t complete = filled;
+        if (!endOfInput) {
+            const void* newline = ::memrchr(buffer.data(), '\n', filled);
+            complete = newline ? static_cast<const char*>(newline) - buffer.data() + 1 : 0;
+        }
+        if (complete == 0) {
+            continue;
+        }
+
+        CsvCommandReader reader(std::string_view(buffer.data(), complete), lineNumber, streamOffset);
+        while (reader.next(command)) {
+            commands++;
+            try {
+                Trades trades = applyOrderCommand(orderBook, command);
+                for (const Trade& trade : trades) {
+                    output += "TRADE,";
+                    appendNumber(output, trade.getBid().orderId_);
+                    output += ',';
+                    appendNumber(output, trade.getAsk().orderId_);
+                    output += ',';
+                    appendNumber(output, static_cast<std::uint64_t>(trade.getPrice().get()));
+                    output += ',';
+                    appendNumber(output, trade.getBid().quantity_.get());
+                    output += '\n';
+                }
+                totalTrades += trades.size();
+                if (tape) {
+                    tape->record(trades);
+                }
+
+                output += "ACK,";
+                output += actionName(command.action_);
+                output += ',';
+                appendNumber(output, command.orderId_);
+                output += orderBook.orderExists(command.orderId_) ? ",RESTING\n" : ",DONE\n";
+            } catch (const std::exception& e) {
+                output += "REJECT,";
+                output += actionName(command.action_);
+                output += ',';
+                appendNumber(output, command.orderId_);
+                output += ',';
+                output += e.what();
+                output += '\n';
+            }
+        }
+        lineNumber = reader.getLineNumber();
+        streamOffset += complete;
+        if (tape) {
+            tape->commit();
+        }
+
+        std::memmove(buffer.data(), buffer.data() + complete, filled - complete);
+        filled -= complete;
+
+        // One write per input chunk keeps syscalls proportional to reads, not to orders
+        if (!output.empty()) {
+            if (!writeAll(outputFd, output)) {
+                std::cerr << "Error writing order stream results: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            output.clear();
+        }
+    }
+
+    std::cerr << "Stream closed - lines: " << lineNumber << ", commands: " << commands
+              << ", trades: " << totalTrades << ", book size: " << orderBook.getSize() << " orders" << std::endl;
+    return ok;
+}
+
+bool processOrderStreamPath(const std::string& path, OrderBook& orderBook, TradeTape* tape) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    bool ok = processOrderStream(fd, STDOUT_FILENO, orderBook, tape);
+    ::close(fd);
+    return ok;
+}
@@ -0,0 +1,39 @@
+/**
+ * Streaming Ingestion Module
+ * Continuous order flow from stdin or a FIFO with batched acknowledgements
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include "trade_tape.h"
+#include <string>
+
+constexpr std::size_t STREAM_READ_BYTES = 1 << 20; // Initial input buffer (grows for longer lines)
+
+/**
+ * Process CSV order commands from a stream until end of input
+ * Input is read in large chunks and every complete line in a chunk is applied before one
+ * write of the chunk's results. Results are CSV lines on the output descriptor:
+ *   ACK,<action>,<order_id>,<RESTING|DONE>
+ *   TRADE,<bid_id>,<ask_id>,<price>,<quantity>
+ *   REJECT,<action>,<order_id>,<reason>
+ * The engine's console log is suppressed while streaming so the output stays machine readable;
+ * malformed lines and the final summary go to stderr.
+ * @param inputFd Descriptor to read commands from (stdin, a pipe or a FIFO)
+ * @param outputFd Descriptor to write results to
+ * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade (committed after each input chunk)
+ * @return false if reading or writing failed
+ */
+bool processOrderStream(int inputFd, int outputFd, OrderBook& orderBook, TradeTape* tape = nullptr);
+
+/**
+ * Open a FIFO (or any readable path) and stream commands from it to stdout
+ * Opening a FIFO blocks until a writer connects
+ * @param path Path to read from
+ * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade
+ * @return false if the path could not be opened or streaming failed
+ */
+bool processOrderStreamPath(const std::string& path, OrderBook& orderBook, TradeTape* tape = nullptr);
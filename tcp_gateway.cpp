@@ -0,0 +1,726 @@
+/**
+ * TCP Order Gateway Implementation
+ * Edge-triggered epoll server with per-connection byte rings, and an epoll load generator
+ */
+
+#include "tcp_gateway.h"
+#include "byte_order.h"         // Little-endian response fields
+#include "console_mute.h"       // Engine log suppression while serving
+#include "latency_histogram.h"  // Client round-trip latency
+#include "order_router.h"       // Order ownership and fill routing
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>        // TCP_NODELAY
+#include <sys/epoll.h>
+#include <sys/signalfd.h>       // SIGINT/SIGTERM as an epoll source
+#include <sys/socket.h>
+#include <sys/uio.h>            // readv/writev
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * Fixed-capacity byte ring with free-running head/tail counters
+ * Free and filled space are exposed as up to two iovecs so one readv/writev covers the wrap.
+ * With a capacity that is a multiple of the message size and whole messages consumed or
+ * appended at a time, a message never straddles the wrap point.
+ */
+class ByteRing
+{
+    public:
+    explicit ByteRing(std::size_t capacity) : data_(new char[capacity]), capacity_(capacity) {}
+
+    std::size_t size() const { return static_cast<std::size_t>(tail_ - head_); }
+    std::size_t space() const { return capacity_ - size(); }
+
+    /**
+     * Free space, in order, as at most two segments
+     * @return Number of segments filled in
+     */
+    int freeSegments(iovec* segments) const { return segmentsOf(tail_, space(), segments); }
+
+    /**
+     * Filled space, in order, as at most two segments
+     * @return Number of segments filled in
+     */
+    int filledSegments(iovec* segments) const { return segmentsOf(head_, size(), segments); }
+
+    const char* front() const { return data_.get() + head_ % capacity_; }
+    char* back() { return data_.get() + tail_ % capacity_; }
+    void produce(std::size_t bytes) { tail_ += bytes; }
+    void consume(std::size_t bytes) { head_ += bytes; }
+
+    private:
+    int segmentsOf(std::uint64_t position, std::size_t length, iovec* segments) const {
+        if (length == 0) {
+            return 0;
+        }
+        std::size_t start = static_cast<std::size_t>(position % capacity_);
+        std::size_t first = std::min(length, capacity_ - start);
+        segments[0] = {data_.get() + start, first};
+        if (first == length) {
+            return 1;
+        }
+        segments[1] = {data_.get(), length - first};
+        return 2;
+    }
+
+    std::unique_ptr<char[]> data_;
+    std::size_t capacity_;
+    std::uint64_t head_ = 0; // Total bytes consumed
+    std::uint64_t tail_ = 0; // Total bytes produced
+};
+
+static_assert(GATEWAY_INPUT_RING_BYTES % GATEWAY_MESSAGE_SIZE == 0, "requests must not wrap");
+static_assert(GATEWAY_OUTPUT_RING_BYTES % GATEWAY_RESPONSE_SIZE == 0, "responses must not wrap");
+
+bool setNonBlocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void setNoDelay(int fd) {
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+sockaddr_in loopbackAddress(std::uint16_t port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+/**
+ * Read until the socket is drained or the ring is full
+ * @param eof Set when the peer closed its sending side
+ * @return Bytes read, or -1 on a socket error
+ */
+ssize_t drainSocket(int fd, ByteRing& ring, bool& eof) {
+    ssize_t total = 0;
+    while (ring.space() > 0) {
+        iovec segments[2];
+        int count = ring.freeSegments(segments);
+        ssize_t n = ::readv(fd, segments, count);
+        if (n > 0) {
+            ring.produce(static_cast<std::size_t>(n));
+            total += n;
+        } else if (n == 0) {
+            eof = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return -1;
+        }
+    }
+    return total;
+}
+
+/**
+ * Write as much of the ring as the socket accepts
+ * @return false on a socket error
+ */
+bool flushSocket(int fd, ByteRing& ring) {
+    while (ring.size() > 0) {
+        iovec segments[2];
+        int count = ring.filledSegments(segments);
+        ssize_t n = ::writev(fd, segments, count);
+        if (n > 0) {
+            ring.consume(static_cast<std::size_t>(n));
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true; // EPOLLOUT resumes the flush
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * One client connection on the gateway
+ */
+struct Connection
+{
+    Connection(int fd, std::uint64_t serial) :
+        fd_(fd), serial_(serial), input_(GATEWAY_INPUT_RING_BYTES), output_(GATEWAY_OUTPUT_RING_BYTES) {}
+
+    int fd_;
+    std::uint64_t serial_;        // Distinguishes connections that reuse a descriptor
+    ByteRing input_;              // Received bytes not yet dispatched
+    ByteRing output_;             // Responses not yet written
+    bool backlog_ = false;        // Input ring filled up, so the socket may still hold data
+    bool peerClosed_ = false;     // Client shut down its sending side
+    bool broken_ = false;         // Close at the end of this wakeup
+    bool queuedDispatch_ = false; // Already in this wakeup's dispatch list
+    bool queuedFlush_ = false;    // Already in this wakeup's flush list
+};
+
+/**
+ * Reference to a connection that stays safe to resolve after the connection closes
+ */
+struct ConnectionRef
+{
+    int fd_;
+    std::uint64_t serial_;
+
+    bool operator==(const ConnectionRef&) const = default;
+};
+
+/**
+ * Single-threaded epoll gateway
+ */
+class OrderGateway
+{
+    public:
+    OrderGateway(OrderBook& orderBook, TradeTape* tape) : router_(orderBook, tape), tape_(tape) {}
+
+    ~OrderGateway() {
+        for (auto& connection : connections_) {
+            if (connection) {
+                ::close(connection->fd_);
+            }
+        }
+        for (int fd : {listenFd_, epollFd_, signalFd_}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    /**
+     * Create the listener, the epoll instance and the stop signal descriptor
+     * @param port Port to listen on (0 for any)
+     * @return false with a message on stderr if any step failed
+     */
+    bool start(std::uint16_t port) {
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        if (::pthread_sigmask(SIG_BLOCK, &signals, nullptr) != 0 ||
+            (signalFd_ = ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC)) < 0) {
+            return fail("signalfd");
+        }
+
+        listenFd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd_ < 0) {
+            return fail("socket");
+        }
+        int one = 1;
+        ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in address = loopbackAddress(port);
+        if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            return fail("bind");
+        }
+        if (::listen(listenFd_, SOMAXCONN) != 0) {
+            return fail("listen");
+        }
+        socklen_t length = sizeof(address);
+        ::getsockname(listenFd_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+
+        epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd_ < 0 || !watch(listenFd_, EPOLLIN | EPOLLET) || !watch(signalFd_, EPOLLIN)) {
+            return fail("epoll");
+        }
+        return true;
+    }
+
+    std::uint16_t getPort() const { return port_; }
+    GatewayStats getStats() const {
+        GatewayStats stats = stats_;
+        stats.rejected_ = router_.getRejected();
+        stats.trades_ = router_.getTrades();
+        return stats;
+    }
+
+    /**
+     * Serve until a stop signal arrives
+     * @return false if epoll_wait failed
+     */
+    bool run() {
+        epoll_event events[GATEWAY_MAX_EVENTS];
+        std::vector<ConnectionRef> backlog;
+        bool running = true;
+
+        while (running) {
+            // Connections with unread backlog are serviced again without sleeping
+            int timeout = backlog_.empty() ? -1 : 0;
+            int ready = ::epoll_wait(epollFd_, events, GATEWAY_MAX_EVENTS, timeout);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return fail("epoll_wait");
+            }
+            stats_.wakeups_++;
+
+            // Phase 1: accept and read everything that is ready
+            backlog.swap(backlog_);
+            for (const ConnectionRef& ref : backlog) {
+                if (Connection* connection = lookup(ref)) {
+                    readClient(*connection);
+                }
+            }
+            backlog.clear();
+            for (int i = 0; i < ready; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd_) {
+                    acceptClients();
+                } else if (fd == signalFd_) {
+                    running = false;
+                } else if (Connection* connection = lookup(fd)) {
+                    if (events[i].events & EPOLLIN) {
+                        readClient(*connection);
+                    }
+                    if (events[i].events & EPOLLERR) {
+                        connection->broken_ = true;
+                    }
+                    queueFlush(*connection); // EPOLLOUT, or closing after EPOLLERR/EPOLLHUP
+                }
+            }
+
+            // Phase 2: apply every complete request from this wakeup in one batch
+            std::uint64_t batch = 0;
+            for (const ConnectionRef& ref : dispatch_) {
+                if (Connection* connection = lookup(ref)) {
+                    connection->queuedDispatch_ = false;
+                    batch += dispatch(*connection);
+                }
+            }
+            dispatch_.clear();
+            if (batch > 0) {
+                stats_.batches_++;
+                stats_.maxBatch_ = std::max(stats_.maxBatch_, batch);
+                if (tape_) {
+                    tape_->commit();
+                }
+            }
+
+            // Phase 3: one writev per connection with pending responses
+            for (const ConnectionRef& ref : flush_) {
+                if (Connection* connection = lookup(ref)) {
+                    connection->queuedFlush_ = false;
+                    if (!connection->broken_ && !flushSocket(connection->fd_, connection->output_)) {
+                        connection->broken_ = true;
+                    }
+                    bool finished = connection->peerClosed_ && connection->input_.size() < GATEWAY_MESSAGE_SIZE &&
+                                    connection->output_.size() == 0;
+                    if (connection->broken_ || finished) {
+                        closeClient(*connection);
+                    } else if (connection->backlog_) {
+                        backlog_.push_back(ref);
+                    }
+                }
+            }
+            flush_.clear();
+        }
+        return true;
+    }
+
+    private:
+    bool fail(const char* what) {
+        std::cerr << "Error: gateway " << what << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    bool watch(int fd, std::uint32_t events) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        return ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+
+    Connection* lookup(int fd) {
+        return fd >= 0 && static_cast<std::size_t>(fd) < connections_.size() ? connections_[fd].get() : nullptr;
+    }
+
+    Connection* lookup(const ConnectionRef& ref) {
+        Connection* connection = lookup(ref.fd_);
+        return connection && connection->serial_ == ref.serial_ ? connection : nullptr;
+    }
+
+    void queueDispatch(Connection& connection) {
+        if (!connection.queuedDispatch_) {
+            connection.queuedDispatch_ = true;
+            dispatch_.push_back({connection.fd_, connection.serial_});
+        }
+    }
+
+    void queueFlush(Connection& connection) {
+        if (!connection.queuedFlush_) {
+            connection.queuedFlush_ = true;
+            flush_.push_back({connection.fd_, connection.serial_});
+        }
+    }
+
+    void acceptClients() {
+        while (true) {
+            int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    fail("accept");
+                }
+                return;
+            }
+            setNoDelay(fd);
+            if (static_cast<std::size_t>(fd) >= connections_.size()) {
+                connections_.resize(static_cast<std::size_t>(fd) + 1);
+            }
+            connections_[fd] = std::make_unique<Connection>(fd, ++serial_);
+            if (!watch(fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET)) {
+                fail("epoll_ctl");
+                ::close(fd);
+                connections_[fd].reset();
+                continue;
+            }
+            stats_.connections_++;
+        }
+    }
+
+    void readClient(Connection& connection) {
+        bool eof = false;
+        if (drainSocket(connection.fd_, connection.input_, eof) < 0) {
+            connection.broken_ = true;
+            queueFlush(connection);
+            return;
+        }
+        connection.backlog_ = connection.input_.space() == 0 && !eof;
+        connection.peerClosed_ = connection.peerClosed_ || eof;
+        if (connection.input_.size() >= GATEWAY_MESSAGE_SIZE) {
+            queueDispatch(connection);
+        }
+        queueFlush(connection); // Revisit after dispatch to write responses or finish closing
+    }
+
+    /**
+     * Apply every complete request buffered on a connection
+     * @return Requests applied
+     */
+    std::uint64_t dispatch(Connection& connection) {
+        std::uint64_t applied = 0;
+        OrderCommand command;
+        while (connection.input_.size() >= GATEWAY_MESSAGE_SIZE && !connection.broken_) {
+            bool decoded = decodeBinaryEvent(connection.input_.front(), command);
+            connection.input_.consume(GATEWAY_MESSAGE_SIZE);
+            if (!decoded) {
+                stats_.malformed_++;
+                connection.broken_ = true; // Framing cannot be trusted past a bad record
+                break;
+            }
+            apply(connection, command);
+            applied++;
+        }
+        stats_.messages_ += applied;
+        return applied;
+    }
+
+    void apply(Connection& connection, const OrderCommand& command) {
+        GatewayResponse ack = router_.apply({connection.fd_, connection.serial_}, command,
+            [this](const ConnectionRef& owner, const GatewayResponse& fill) {
+                if (Connection* recipient = lookup(owner)) {
+                    send(*recipient, fill);
+                }
+            });
+        send(connection, ack);
+    }
+
+    void send(Connection& connection, const GatewayResponse& response) {
+        if (connection.broken_) {
+            return;
+        }
+        if (connection.output_.space() < GATEWAY_RESPONSE_SIZE) {
+            stats_.slowConsumers_++;
+            connection.broken_ = true; // Not reading its responses; drop it rather than stall the book
+        } else {
+            encodeGatewayResponse(response, connection.output_.back());
+            connection.output_.produce(GATEWAY_RESPONSE_SIZE);
+        }
+        queueFlush(connection);
+    }
+
+    void closeClient(Connection& connection) {
+        int fd = connection.fd_;
+        ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        connections_[fd].reset();
+    }
+
+    OrderRouter<ConnectionRef> router_;                     // Ownership checks and response routing
+    TradeTape* tape_;
+    int listenFd_ = -1;
+    int epollFd_ = -1;
+    int signalFd_ = -1;
+    std::uint16_t port_ = 0;
+    std::uint64_t serial_ = 0;
+    std::vector<std::unique_ptr<Connection>> connections_; // Indexed by descriptor
+    std::vector<ConnectionRef> dispatch_;                  // Connections with requests this wakeup
+    std::vector<ConnectionRef> flush_;                     // Connections to write this wakeup
+    std::vector<ConnectionRef> backlog_;                   // Connections to read again without waiting
+    GatewayStats stats_;
+};
+
+} // namespace
+
+void encodeGatewayResponse(const GatewayResponse& response, char* out) {
+    out[0] = static_cast<char>(response.type_);
+    out[1] = static_cast<char>(response.action_);
+    out[2] = static_cast<char>(response.status_);
+    out[3] = 0;
+    storeLittleEndian<std::uint32_t>(out + 4, response.quantity_);
+    storeLittleEndian<std::uint64_t>(out + 8, response.orderId_);
+    storeLittleEndian<std::uint64_t>(out + 16, response.aux_);
+    storeLittleEndian<std::uint32_t>(out + 24, static_cast<std::uint32_t>(response.price_));
+    storeLittleEndian<std::uint32_t>(out + 28, 0);
+}
+
+bool decodeGatewayResponse(const char* in, GatewayResponse& response) {
+    std::uint8_t type = static_cast<std::uint8_t>(in[0]);
+    if (type < static_cast<std::uint8_t>(GatewayResponseType::ACK) ||
+        type > static_cast<std::uint8_t>(GatewayResponseType::REJECT)) {
+        return false;
+    }
+    response.type_ = static_cast<GatewayResponseType>(type);
+    response.action_ = static_cast<OrderAction>(in[1]);
+    response.status_ = static_cast<std::uint8_t>(in[2]);
+    response.quantity_ = loadLittleEndian<std::uint32_t>(in + 4);
+    response.orderId_ = loadLittleEndian<std::uint64_t>(in + 8);
+    response.aux_ = loadLittleEndian<std::uint64_t>(in + 16);
+    response.price_ = static_cast<std::int32_t>(loadLittleEndian<std::uint32_t>(in + 24));
+    return true;
+}
+
+bool runOrderGateway(std::uint16_t port, OrderBook& orderBook, TradeTape* tape) {
+    OrderGateway gateway(orderBook, tape);
+    if (!gateway.start(port)) {
+        return false;
+    }
+
+    std::cout << "Order gateway listening on 127.0.0.1:" << gateway.getPort() << " (Ctrl-C to stop)" << std::endl;
+    bool ok;
+    {
+        ConsoleMute mute;
+        ok = gateway.run();
+    }
+
+    GatewayStats stats = gateway.getStats();
+    std::cout << "=================================================\n";
+    std::cout << "Order Gateway Stopped!\n";
+    std::cout << "Connections accepted: " << stats.connections_ << "\n";
+    std::cout << "Messages processed: " << stats.messages_ << " (" << stats.rejected_ << " rejected, "
+              << stats.malformed_ << " malformed)\n";
+    std::cout << "Total trades executed: " << stats.trades_ << "\n";
+    std::cout << "Final order book size: " << orderBook.getSize() << " orders\n";
+    std::cout << "Wakeups: " << stats.wakeups_ << ", batches: " << stats.batches_
+              << ", largest batch: " << stats.maxBatch_ << ", mean batch: " << std::fixed << std::setprecision(1)
+              << (stats.batches_ ? static_cast<double>(stats.messages_) / static_cast<double>(stats.batches_) : 0.0)
+              << "\n";
+    if (stats.slowConsumers_ != 0) {
+        std::cout << "Slow consumers dropped: " << stats.slowConsumers_ << "\n";
+    }
+    return ok;
+}
+
+namespace {
+
+constexpr std::uint64_t LOAD_WINDOW = 8;         // Requests in flight per client
+constexpr OrderId LOAD_ID_RANGE = 1'000'000'000; // Order ids reserved per client
+
+/**
+ * One simulated client
+ */
+struct LoadClient
+{
+    explicit LoadClient(int fd) : fd_(fd), input_(GATEWAY_INPUT_RING_BYTES), output_(GATEWAY_INPUT_RING_BYTES) {}
+
+    int fd_;
+    ByteRing input_;                // Responses not yet decoded
+    ByteRing output_;               // Requests not yet written
+    std::mt19937_64 random_;        // Order flow
+    OrderId nextId_ = 0;
+    std::vector<OrderId> resting_;  // Own orders that may still rest (cancel candidates)
+    std::uint64_t sent_ = 0;
+    std::uint64_t acknowledged_ = 0;
+    bool done_ = false;
+};
+
+std::uint64_t steadyNanos() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Top up a client's window of requests and write whatever the socket accepts
+ * @return false on a socket error
+ */
+bool pumpLoadClient(LoadClient& client, std::uint64_t ordersPerClient) {
+    while (client.sent_ < ordersPerClient && client.sent_ - client.acknowledged_ < LOAD_WINDOW &&
+           client.output_.space() >= GATEWAY_MESSAGE_SIZE) {
+        OrderCommand command{};
+        if (!client.resting_.empty() && client.random_() % 4 == 0) {
+            std::size_t index = static_cast<std::size_t>(client.random_() % client.resting_.size());
+            command.action_ = OrderAction::CANCEL;
+            command.orderId_ = client.resting_[index];
+            client.resting_[index] = client.resting_.back();
+            client.resting_.pop_back();
+        } else {
+            command.action_ = OrderAction::CREATE;
+            command.orderId_ = client.nextId_++;
+            command.side_ = client.random_() % 2 ? OrderSide::BUY : OrderSide::SELL;
+            command.type_ = OrderType::GTC;
+            command.price_ = static_cast<std::int32_t>(95 + client.random_() % 11);
+            command.quantity_ = static_cast<std::uint32_t>(1 + client.random_() % 100);
+        }
+        command.timestamp_ = steadyNanos();
+        encodeBinaryEvent(command, client.output_.back());
+        client.output_.produce(GATEWAY_MESSAGE_SIZE);
+        client.sent_++;
+    }
+    return flushSocket(client.fd_, client.output_);
+}
+
+} // namespace
+
+bool runGatewayLoad(std::uint16_t port, unsigned clients, std::uint64_t ordersPerClient) {
+    int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        std::cerr << "Error: epoll_create1 failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    std::vector<std::unique_ptr<LoadClient>> pool;
+    bool ok = true;
+    sockaddr_in address = loopbackAddress(port);
+    for (unsigned i = 0; i < clients && ok; ++i) {
+        int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            !setNonBlocking(fd)) {
+            std::cerr << "Error: Cannot connect client " << i << " to 127.0.0.1:" << port << ": "
+                      << std::strerror(errno) << std::endl;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            ok = false;
+            break;
+        }
+        setNoDelay(fd);
+        auto client = std::make_unique<LoadClient>(fd);
+        client->random_.seed(i + 1);
+        client->nextId_ = (i + 1) * LOAD_ID_RANGE;
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLET;
+        event.data.u32 = i;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        pool.push_back(std::move(client));
+    }
+
+    LatencyHistogram latency;
+    std::uint64_t fills = 0;
+    std::uint64_t rejects = 0;
+    std::size_t active = pool.size();
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto& client : pool) {
+        ok = ok && pumpLoadClient(*client, ordersPerClient);
+        if (ordersPerClient == 0) {
+            client->done_ = true;
+            active--;
+        }
+    }
+
+    epoll_event events[GATEWAY_MAX_EVENTS];
+    while (ok && active > 0) {
+        int ready = ::epoll_wait(epollFd, events, GATEWAY_MAX_EVENTS, 5000);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            std::cerr << "Error: gateway stopped responding" << std::endl;
+            ok = false;
+            break;
+        }
+        for (int i = 0; i < ready && ok; ++i) {
+            LoadClient& client = *pool[events[i].data.u32];
+            if (client.done_) {
+                continue;
+            }
+            bool eof = false;
+            if (drainSocket(client.fd_, client.input_, eof) < 0 || eof) {
+                std::cerr << "Error: gateway closed a client connection early" << std::endl;
+                ok = false;
+                break;
+            }
+
+            std::uint64_t now = steadyNanos();
+            GatewayResponse response;
+            while (client.input_.size() >= GATEWAY_RESPONSE_SIZE) {
+                bool decoded = decodeGatewayResponse(client.input_.front(), response);
+                client.input_.consume(GATEWAY_RESPONSE_SIZE);
+                if (!decoded) {
+                    continue;
+                }
+                if (response.type_ == GatewayResponseType::FILL) {
+                    fills++;
+                    continue;
+                }
+                client.acknowledged_++;
+                latency.record(now - response.aux_);
+                if (response.type_ == GatewayResponseType::REJECT) {
+                    rejects++;
+                } else if (response.action_ == OrderAction::CREATE && response.status_ == 1) {
+                    client.resting_.push_back(response.orderId_);
+                }
+            }
+
+            if (client.acknowledged_ == ordersPerClient) {
+                client.done_ = true;
+                active--;
+            } else {
+                ok = pumpLoadClient(client, ordersPerClient);
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t acknowledged = 0;
+    for (auto& client : pool) {
+        acknowledged += client->acknowledged_;
+        ::close(client->fd_);
+    }
+    ::close(epollFd);
+
+    std::cout << "=================================================\n";
+    std::cout << "Gateway Load Complete!\n";
+    std::cout << "Clients: " << pool.size() << ", requests acknowledged: " << acknowledged
+              << " (" << rejects << " rejected), fills received: " << fills << "\n";
+    std::cout << "Elapsed: " << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms, "
+              << std::setprecision(0) << (seconds > 0 ? static_cast<double>(acknowledged) / seconds : 0.0)
+              << " requests/s\n";
+    std::cout << "Round trip (ns): min " << latency.min()
+              << " p50 " << latency.percentile(50) << " p90 " << latency.percentile(90)
+              << " p99 " << latency.percentile(99) << " p99.9 " << latency.percentile(99.9)
+              << " max " << latency.max() << " mean " << std::setprecision(0) << latency.mean() << "\n";
+    return ok;
+}
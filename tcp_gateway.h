@@ -0,0 +1,106 @@
+/**
+ * TCP Order Gateway Module
+ * Loopback network front end for the engine and a load generator that drives it
+ *
+ * Clients send the 32-byte binary event records (see binary_events.h) back to back with no
+ * file header. Every message gets an ACK or REJECT on the same connection, and every trade
+ * sends a FILL to the connections that own the bid and the ask. Responses are 32 bytes,
+ * little-endian:
+ *   u8 type, u8 action, u8 status, u8 reserved, u32 quantity,
+ *   u64 order id, u64 aux, i32 price, 4 reserved bytes (zero)
+ *   ACK:    status 1 if the order rests in the book, 0 if done; aux echoes the request timestamp
+ *   REJECT: aux echoes the request timestamp; sent when the engine refuses the request, a
+ *           CREATE reuses an id that is still resting, or a CANCEL/MODIFY names an order the
+ *           connection does not own (including one that has already filled or been cancelled)
+ *   FILL:   status is the recipient's side, aux is the counterparty order id
+ */
+
+#pragma once
+
+#include "binary_events.h"
+#include "orderbook.h"
+#include "order_command.h"
+#include "trade_tape.h"
+#include <cstdint>
+
+constexpr std::size_t GATEWAY_MESSAGE_SIZE = BINARY_EVENT_RECORD_SIZE;
+constexpr std::size_t GATEWAY_RESPONSE_SIZE = 32;
+constexpr std::size_t GATEWAY_INPUT_RING_BYTES = 64 * 1024;   // Per-connection request ring
+constexpr std::size_t GATEWAY_OUTPUT_RING_BYTES = 1 << 20;    // Per-connection response ring
+constexpr int GATEWAY_MAX_EVENTS = 256;                       // epoll events per wakeup
+
+enum class GatewayResponseType : std::uint8_t
+{
+    ACK = 1,    // Request applied
+    FILL = 2,   // One side of a trade
+    REJECT = 3  // Request refused by the engine
+};
+
+/**
+ * Decoded gateway response
+ */
+struct GatewayResponse
+{
+    GatewayResponseType type_;
+    OrderAction action_;      // Action of the request (ACK/REJECT)
+    std::uint8_t status_;     // ACK: 1 resting, 0 done; FILL: recipient's OrderSide
+    std::uint32_t quantity_;  // FILL quantity
+    OrderId orderId_;         // Order the response is about
+    std::uint64_t aux_;       // ACK/REJECT: request timestamp; FILL: counterparty order id
+    std::int32_t price_;      // FILL price
+};
+
+/**
+ * Write one response
+ * @param response Response to encode
+ * @param out Destination of GATEWAY_RESPONSE_SIZE bytes
+ */
+void encodeGatewayResponse(const GatewayResponse& response, char* out);
+
+/**
+ * Read one response
+ * @param in Start of the response
+ * @param response Receives the decoded response
+ * @return false if the type byte is not a known value
+ */
+bool decodeGatewayResponse(const char* in, GatewayResponse& response);
+
+/**
+ * Counters reported when the gateway stops
+ */
+struct GatewayStats
+{
+    std::uint64_t connections_ = 0;   // Clients accepted
+    std::uint64_t messages_ = 0;      // Requests applied or rejected
+    std::uint64_t rejected_ = 0;      // Requests refused (by the engine or the ownership checks)
+    std::uint64_t malformed_ = 0;     // Records that did not decode
+    std::uint64_t trades_ = 0;        // Trades executed
+    std::uint64_t wakeups_ = 0;       // epoll_wait returns
+    std::uint64_t batches_ = 0;       // Wakeups that dispatched at least one request
+    std::uint64_t maxBatch_ = 0;      // Most requests dispatched in one wakeup
+    std::uint64_t slowConsumers_ = 0; // Clients dropped because their response ring filled
+};
+
+/**
+ * Serve order entry on 127.0.0.1 until SIGINT or SIGTERM
+ * One thread runs an edge-triggered epoll loop. Each wakeup drains every readable socket
+ * into its connection's ring, applies all complete requests from that wakeup in one batch,
+ * then writes each connection's pending responses with one writev. The engine's console log
+ * is suppressed while serving.
+ * @param port Port to listen on (0 picks a free port, which is printed)
+ * @param orderBook Order book instance to process orders against
+ * @param tape Optional tape receiving every trade (committed after each batch)
+ * @return false if the listener could not be set up or the event loop failed
+ */
+bool runOrderGateway(std::uint16_t port, OrderBook& orderBook, TradeTape* tape = nullptr);
+
+/**
+ * Drive a gateway on 127.0.0.1 with simulated clients and report round-trip latency
+ * Each client keeps a small window of orders in flight, mostly new limit orders around a
+ * common price with some cancels of its own resting orders, using its own order id range.
+ * @param port Gateway port
+ * @param clients Number of concurrent connections
+ * @param ordersPerClient Requests each client sends
+ * @return false if connecting failed or a connection broke before all requests were acknowledged
+ */
+bool runGatewayLoad(std::uint16_t port, unsigned clients, std::uint64_t ordersPerClient);
@@ -0,0 +1,198 @@
+/**
+ * Trade Tape Implementation
+ * Contiguous buffering with one write per flush
+ */
+
+#include "trade_tape.h"
+#include "byte_order.h"   // Little-endian binary records
+#include <cerrno>
+#include <charconv>       // Allocation-free CSV formatting
+#include <cstring>
+#include <fcntl.h>        // open
+#include <unistd.h>       // write/fdatasync/close
+
+namespace {
+
+constexpr std::size_t CSV_RECORD_MAX = 128; // Room for one formatted CSV line
+
+// Longest CSV line: 20-digit sequence and order ids, an 11-character price, a 10-digit quantity,
+// five commas, "SELL" and the newline
+static_assert(3 * 20 + 11 + 10 + 5 + 4 + 1 <= CSV_RECORD_MAX, "CSV records must fit their buffer");
+
+std::uint8_t aggressorCode(const Trade& trade) {
+    if (!trade.getAggressor()) {
+        return 2;
+    }
+    return *trade.getAggressor() == OrderSide::BUY ? 0 : 1;
+}
+
+std::size_t encodeBinary(const Trade& trade, std::uint64_t sequence, char* out) {
+    storeLittleEndian<std::uint64_t>(out, sequence);
+    storeLittleEndian<std::uint64_t>(out + 8, trade.getBid().orderId_);
+    storeLittleEndian<std::uint64_t>(out + 16, trade.getAsk().orderId_);
+    storeLittleEndian<std::uint32_t>(out + 24, static_cast<std::uint32_t>(trade.getPrice().get()));
+    storeLittleEndian<std::uint32_t>(out + 28, trade.getBid().quantity_.get());
+    out[32] = static_cast<char>(aggressorCode(trade));
+    std::memset(out + 33, 0, TRADE_TAPE_RECORD_SIZE - 33);
+    return TRADE_TAPE_RECORD_SIZE;
+}
+
+std::size_t encodeCsv(const Trade& trade, std::uint64_t sequence, char* out) {
+    static const char* aggressorNames[] = {"BUY", "SELL", "NONE"};
+    char* cursor = out;
+    char* end = out + CSV_RECORD_MAX;
+    bool fits = true;
+
+    // Append one number and the separator after it
+    auto field = [&](auto value) {
+        auto [ptr, ec] = std::to_chars(cursor, end, value);
+        if (ec != std::errc() || ptr == end) {
+            fits = false;
+            return;
+        }
+        cursor = ptr;
+        *cursor++ = ',';
+    };
+    field(sequence);
+    field(trade.getBid().orderId_);
+    field(trade.getAsk().orderId_);
+    field(trade.getPrice().get());
+    field(trade.getBid().quantity_.get());
+
+    const char* aggressor = aggressorNames[aggressorCode(trade)];
+    std::size_t length = std::strlen(aggressor);
+    if (!fits || static_cast<std::size_t>(end - cursor) <= length) {
+        return 0; // Unreachable given the static_assert above
+    }
+    std::memcpy(cursor, aggressor, length);
+    cursor += length;
+    *cursor++ = '\n';
+    return static_cast<std::size_t>(cursor - out);
+}
+
+} // namespace
+
+TradeTape::TradeTape(const std::string& path, TapeFormat format, TapeDurability durability)
+    : fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+      format_(format),
+      durability_(durability),
+      buffer_(TRADE_TAPE_BUFFER_BYTES) {
+    if (fd_ < 0) {
+        return;
+    }
+
+    if (format_ == TapeFormat::BINARY) {
+        char header[TRADE_TAPE_HEADER_SIZE] = {};
+        std::memcpy(header, TRADE_TAPE_MAGIC, sizeof(TRADE_TAPE_MAGIC));
+        storeLittleEndian<std::uint16_t>(header + 4, TRADE_TAPE_VERSION);
+        storeLittleEndian<std::uint16_t>(header + 6, TRADE_TAPE_RECORD_SIZE);
+        append(header, sizeof(header));
+    } else {
+        static const char header[] = "sequence,bid_order_id,ask_order_id,price,quantity,aggressor\n";
+        append(header, sizeof(header) - 1);
+    }
+}
+
+TradeTape::~TradeTape() {
+    close();
+}
+
+void TradeTape::append(const char* data, std::size_t size) {
+    if (failed_ || fd_ < 0) {
+        return; // Counted as lost at close(), or the tape is already closed
+    }
+    if (used_ + size > buffer_.size()) {
+        flush();
+    }
+    std::memcpy(buffer_.data() + used_, data, size);
+    used_ += size;
+}
+
+void TradeTape::record(const Trades& trades) {
+    char encoded[CSV_RECORD_MAX];
+    for (const Trade& trade : trades) {
+        std::size_t size = format_ == TapeFormat::BINARY
+            ? encodeBinary(trade, ++sequence_, encoded)
+            : encodeCsv(trade, ++sequence_, encoded);
+        append(encoded, size);
+    }
+}
+
+void TradeTape::flush() {
+    if (fd_ < 0 || used_ == 0) {
+        return;
+    }
+
+    // Short writes resume where the kernel stopped
+    std::size_t written = 0;
+    while (written < used_) {
+        ssize_t n = ::write(fd_, buffer_.data() + written, used_ - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error writing trade tape: " << std::strerror(errno) << std::endl;
+            failed_ = true;
+            break;
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    used_ = 0;
+    if (!failed_) {
+        writtenSequence_ = sequence_;
+    }
+}
+
+void TradeTape::commit() {
+    if (durability_ == TapeDurability::BUFFERED) {
+        return;
+    }
+    flush();
+    if (durability_ == TapeDurability::SYNC && fd_ >= 0 && ::fdatasync(fd_) != 0) {
+        std::cerr << "Error syncing trade tape: " << std::strerror(errno) << std::endl;
+        failed_ = true;
+    }
+}
+
+bool TradeTape::close() {
+    if (fd_ < 0) {
+        return !failed_;
+    }
+    flush();
+    if (failed_) {
+        std::cerr << "Error: trade tape lost " << (sequence_ - writtenSequence_) << " trade(s) after sequence "
+                  << writtenSequence_ << " (the last one fully written)" << std::endl;
+    }
+    if (durability_ == TapeDurability::SYNC && ::fdatasync(fd_) != 0) {
+        failed_ = true;
+    }
+    if (::close(fd_) != 0) {
+        failed_ = true;
+    }
+    fd_ = -1;
+    return !failed_;
+}
+
+bool parseTapeFormat(const std::string& name, TapeFormat& format) {
+    if (name == "binary") {
+        format = TapeFormat::BINARY;
+    } else if (name == "csv") {
+        format = TapeFormat::CSV;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseTapeDurability(const std::string& name, TapeDurability& durability) {
+    if (name == "buffered") {
+        durability = TapeDurability::BUFFERED;
+    } else if (name == "commit") {
+        durability = TapeDurability::COMMIT;
+    } else if (name == "sync") {
+        durability = TapeDurability::SYNC;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+/**
+ * Trade Tape Module
+ * Buffered writer that records every trade for downstream clearing
+ *
+ * Binary layout:
+ *   header (16 bytes): magic "OBTT", u16 version, u16 record size, 8 reserved bytes
+ *   records (40 bytes each, little-endian):
+ *     u64 sequence, u64 bid order id, u64 ask order id, i32 price, u32 quantity,
+ *     u8 aggressor (0 buy, 1 sell, 2 none), 7 reserved bytes
+ * CSV layout: sequence,bid_order_id,ask_order_id,price,quantity,aggressor
+ */
+
+#pragma once
+
+#include "orderbook.h"
+#include <string>
+#include <vector>
+
+constexpr char TRADE_TAPE_MAGIC[4] = {'O', 'B', 'T', 'T'};
+constexpr std::uint16_t TRADE_TAPE_VERSION = 1;
+constexpr std::size_t TRADE_TAPE_HEADER_SIZE = 16;
+constexpr std::size_t TRADE_TAPE_RECORD_SIZE = 40;
+constexpr std::size_t TRADE_TAPE_BUFFER_BYTES = 4 * 1024 * 1024; // Encoded trades held between writes
+
+/**
+ * Tape encoding
+ */
+enum class TapeFormat
+{
+    BINARY, // fixed-width little-endian records
+    CSV     // one text line per trade
+};
+
+/**
+ * When buffered trades reach the file
+ */
+enum class TapeDurability
+{
+    BUFFERED, // written when the buffer fills and on close - fastest, a crash loses the buffered tail
+    COMMIT,   // written at every commit() - survives a process crash
+    SYNC      // written and fdatasync'd at every commit() - survives power loss
+};
+
+/**
+ * Append-only trade tape
+ * Trades are encoded into one contiguous buffer that goes to the kernel in a single write()
+ * when it fills (or at a commit), so steady-state replay costs one syscall per few MiB.
+ * After a failed write nothing more is written, and close() reports how many trades were lost.
+ */
+class TradeTape
+{
+    public:
+    /**
+     * Create or truncate a tape file
+     * @param path Output path
+     * @param format Record encoding
+     * @param durability Flush policy
+     */
+    TradeTape(const std::string& path, TapeFormat format, TapeDurability durability);
+    ~TradeTape();
+
+    TradeTape(const TradeTape&) = delete;
+    TradeTape& operator=(const TradeTape&) = delete;
+
+    /**
+     * Check whether the file was created and all writes so far succeeded
+     * @return true if the tape is usable
+     */
+    bool isOpen() const { return fd_ >= 0 && !failed_; }
+
+    /**
+     * Append trades with consecutive sequence numbers
+     * Trades recorded after close() or a failed write are dropped
+     * @param trades Trades to record
+     */
+    void record(const Trades& trades);
+
+    /**
+     * Mark a durability point - flushes (and syncs) according to the policy
+     */
+    void commit();
+
+    /**
+     * Write everything buffered and close the file
+     * Reports on stderr how many trades never reached the file if a write failed
+     * @return true if every write succeeded
+     */
+    bool close();
+
+    /**
+     * Sequence number of the last recorded trade (0 before the first)
+     */
+    std::uint64_t getSequence() const { return sequence_; }
+
+    private:
+    void append(const char* data, std::size_t size);
+    void flush();
+
+    int fd_;                          // Output descriptor
+    TapeFormat format_;               // Record encoding
+    TapeDurability durability_;       // Flush policy
+    std::vector<char> buffer_;        // TRADE_TAPE_BUFFER_BYTES, filled front to back
+    std::size_t used_ = 0;            // Bytes buffered
+    std::uint64_t sequence_ = 0;      // Last sequence number assigned
+    std::uint64_t writtenSequence_ = 0; // Last sequence number known to be in the file
+    bool failed_ = false;             // A write failed; later trades are dropped
+};
+
+/**
+ * Parse a tape format name
+ * @param name "binary" or "csv"
+ * @param format Receives the format
+ * @return false if the name is unknown
+ */
+bool parseTapeFormat(const std::string& name, TapeFormat& format);
+
+/**
+ * Parse a durability policy name
+ * @param name "buffered", "commit" or "sync"
+ * @param durability Receives the policy
+ * @return false if the name is unknown
+ */
+bool parseTapeDurability(const std::string& name, TapeDurability& durability);
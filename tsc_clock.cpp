@@ -0,0 +1,70 @@
+/**
+ * TSC Clock Implementation
+ * Invariant TSC detection and calibration
+ */
+
+#include "tsc_clock.h"
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define TSC_CLOCK_X86 1
+#endif
+
+namespace {
+
+std::uint64_t steadyNanos() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool hasInvariantTsc() {
+#ifdef TSC_CLOCK_X86
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0; // Constant rate across P/C-states and cores
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+TscClock::TscClock(unsigned calibrationMillis) : useTsc_(hasInvariantTsc()), nanosPerTick_(1.0) {
+    if (!useTsc_) {
+        return;
+    }
+
+    std::uint64_t startNanos = steadyNanos();
+    std::uint64_t startTicks = now();
+    std::uint64_t endNanos = startNanos;
+    while (endNanos - startNanos < calibrationMillis * 1000000ull) {
+        endNanos = steadyNanos();
+    }
+    std::uint64_t endTicks = now();
+    nanosPerTick_ = static_cast<double>(endNanos - startNanos) / static_cast<double>(endTicks - startTicks);
+}
+
+std::uint64_t TscClock::now() const {
+#ifdef TSC_CLOCK_X86
+    if (useTsc_) {
+        return __rdtsc();
+    }
+#endif
+    return steadyNanos();
+}
+
+std::uint64_t TscClock::waitUntil(std::uint64_t deadline) const {
+    std::uint64_t current = now();
+    while (current < deadline) {
+#ifdef TSC_CLOCK_X86
+        _mm_pause();
+#endif
+        current = now();
+    }
+    return current;
+}
@@ -0,0 +1,64 @@
+/**
+ * TSC Clock Module
+ * Cycle-counter timestamps for busy-wait pacing and latency measurement
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Monotonic clock read from the time-stamp counter when the CPU has an invariant TSC,
+ * otherwise from std::chrono::steady_clock
+ * Construction calibrates ticks against steady_clock, so create one per run, not per event
+ */
+class TscClock
+{
+    public:
+    /**
+     * Calibrate the clock
+     * @param calibrationMillis How long to measure the tick rate for
+     */
+    explicit TscClock(unsigned calibrationMillis = 20);
+
+    /**
+     * Read the clock
+     * @return Ticks (TSC cycles, or nanoseconds when the TSC is not usable)
+     */
+    std::uint64_t now() const;
+
+    /**
+     * Convert a tick interval to nanoseconds
+     * @param ticks Tick interval
+     * @return Nanoseconds
+     */
+    std::uint64_t toNanos(std::uint64_t ticks) const {
+        return static_cast<std::uint64_t>(static_cast<double>(ticks) * nanosPerTick_);
+    }
+
+    /**
+     * Convert nanoseconds to a tick interval
+     * @param nanos Nanoseconds
+     * @return Ticks
+     */
+    std::uint64_t fromNanos(std::uint64_t nanos) const {
+        return static_cast<std::uint64_t>(static_cast<double>(nanos) / nanosPerTick_);
+    }
+
+    /**
+     * Spin until the clock reaches a deadline
+     * @param deadline Tick value to wait for
+     * @return Clock value when the wait ended
+     */
+    std::uint64_t waitUntil(std::uint64_t deadline) const;
+
+    /**
+     * Whether the TSC is in use
+     * @return false when falling back to steady_clock
+     */
+    bool usesTsc() const { return useTsc_; }
+
+    private:
+    bool useTsc_;          // Invariant TSC available
+    double nanosPerTick_;  // Calibrated tick length
+};
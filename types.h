@@ -103,3 +103,8 @@ public:
 
 // Keep OrderId as alias for now - it's less likely to be confused with other types
 using OrderId = std::uint64_t;
+
+// Owner/account identifier used for self-trade prevention
+using OwnerId = std::uint32_t;
+constexpr OwnerId NO_OWNER = 0;                         // Order not attributed to any owner
+constexpr OwnerId RESERVED_OWNER = static_cast<OwnerId>(-1); // Never assigned - marks STP as disabled